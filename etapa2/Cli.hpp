@@ -0,0 +1,115 @@
+#pragma once
+#include <iostream>
+#include <vector>
+#include <string>
+#include <sstream>
+#include <thread>
+#include <atomic>
+#include <functional>
+#include <algorithm>
+#include "RunSummary.hpp"
+
+using namespace std;
+
+// Opções da execução sem menu interativo (modo headless)
+struct CliOptions {
+    vector<string> instancePatterns;   // Nomes ou padrões (*, ?) de arquivos da pasta 'entradas'
+    int mode = 2;                      // 1: Estatísticas, 2: Solução, 3: Ambos
+    int threads = max(1u, thread::hardware_concurrency());
+    unsigned seed = 0;
+    bool hasSeed = false;
+    double timeLimitSeconds = 0;       // Aceito por compatibilidade com a etapa 3; a etapa 2 não tem fase de busca
+    string summaryPath = "resumo.csv";
+    bool help = false;
+};
+
+// Imprime a ajuda das opções de linha de comando
+inline void printUsage(const string& program) {
+    cout << "Uso: " << program << " [opções]\n"
+         << "  Sem opções, o programa abre o menu interativo.\n\n"
+         << "  --instances <lista>   Arquivos de 'entradas', separados por vírgula; aceita * e ? (padrão: todos)\n"
+         << "  --mode <1|2|3>        1: estatísticas, 2: solução, 3: ambos (padrão: 2)\n"
+         << "  --threads <n>         Instâncias processadas em paralelo (padrão: núcleos disponíveis)\n"
+         << "  --seed <n>            Semente do gerador aleatório (padrão: relógio)\n"
+         << "  --time-limit <s>      Limite de tempo por instância; sem efeito na etapa 2 (só há fase construtiva)\n"
+         << "  --summary <arquivo>   Resumo por instância; .json gera JSON, outra extensão gera CSV (padrão: resumo.csv)\n"
+         << "  --help                Mostra esta ajuda" << endl;
+}
+
+// Compara um nome com um padrão contendo os curingas '*' e '?'
+inline bool wildcardMatch(const string& pattern, const string& text) {
+    size_t p = 0, t = 0, star = string::npos, mark = 0;
+    while (t < text.size()) {
+        if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == text[t])) { ++p; ++t; }
+        else if (p < pattern.size() && pattern[p] == '*') { star = p++; mark = t; }
+        else if (star != string::npos) { p = star + 1; t = ++mark; }
+        else return false;
+    }
+    while (p < pattern.size() && pattern[p] == '*') ++p;
+    return p == pattern.size();
+}
+
+// Lê as opções de linha de comando; retorna false e preenche 'error' se alguma for inválida
+inline bool parseCliOptions(int argc, char* argv[], CliOptions& options, string& error) {
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        auto value = [&]() -> string {
+            if (i + 1 >= argc) throw invalid_argument("a opção " + arg + " exige um valor");
+            return argv[++i];
+        };
+        try {
+            if (arg == "--help" || arg == "-h") options.help = true;
+            else if (arg == "--instances") {
+                stringstream ss(value());
+                string item;
+                while (getline(ss, item, ',')) if (!item.empty()) options.instancePatterns.push_back(item);
+            }
+            else if (arg == "--mode") options.mode = stoi(value());
+            else if (arg == "--threads") options.threads = stoi(value());
+            else if (arg == "--seed") { options.seed = stoul(value()); options.hasSeed = true; }
+            else if (arg == "--time-limit") options.timeLimitSeconds = stod(value());
+            else if (arg == "--summary") options.summaryPath = value();
+            else { error = "opção desconhecida: " + arg; return false; }
+        } catch (const exception& e) {
+            error = "valor inválido para " + arg + " (" + e.what() + ")";
+            return false;
+        }
+    }
+    if (options.mode < 1 || options.mode > 3) { error = "--mode deve ser 1, 2 ou 3"; return false; }
+    if (options.threads < 1) { error = "--threads deve ser positivo"; return false; }
+    if (options.timeLimitSeconds < 0) { error = "--time-limit não pode ser negativo"; return false; }
+    return true;
+}
+
+// Seleciona, entre os arquivos disponíveis, os que correspondem a algum dos padrões
+inline vector<string> filterInstances(const vector<string>& available, const vector<string>& patterns) {
+    if (patterns.empty()) return available;
+    vector<string> selected;
+    for (const auto& filename : available) {
+        for (const auto& pattern : patterns) {
+            if (wildcardMatch(pattern, filename)) {
+                selected.push_back(filename);
+                break;
+            }
+        }
+    }
+    return selected;
+}
+
+// Processa as instâncias em 'threads' threads; 'process' preenche as estatísticas de cada uma
+inline vector<InstanceStats> runBatch(const vector<string>& files, int threads,
+                                      const function<bool(const string&, InstanceStats&)>& process) {
+    vector<InstanceStats> stats(files.size());
+    atomic<size_t> next{0};
+    auto worker = [&]() {
+        for (size_t i = next++; i < files.size(); i = next++) {
+            stats[i].instance = files[i];
+            stats[i].ok = process(files[i], stats[i]);
+            stats[i].processPeakRssKb = peakRssKb();
+        }
+    };
+    vector<thread> workers;
+    for (int t = 0; t < min<int>(threads, files.size()); ++t) workers.emplace_back(worker);
+    for (auto& w : workers) w.join();
+    return stats;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <sys/resource.h>
+
+using namespace std;
+
+// Uma linha do resumo de uma execução: resultado e tempos (em microssegundos) de uma instância
+struct InstanceStats {
+    string instance;
+    bool ok = false;
+    long long cost = -1;
+    int routes = 0;
+    long long parseTime = 0;
+    long long apspTime = 0;
+    long long constructionTime = 0;
+    long long localSearchTime = 0;
+    long processPeakRssKb = 0; // Pico do processo inteiro até o fim da instância (cumulativo no lote)
+};
+
+// Retorna o pico de memória residente do processo até o momento, em KB. É a marca máxima do processo
+// inteiro (getrusage), não de uma instância: com instâncias em paralelo, cada linha mostra o maior pico do lote até ali
+inline long peakRssKb() {
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+    return usage.ru_maxrss;
+}
+
+// Escapa aspas e barras invertidas para uso dentro de uma string JSON
+inline string jsonEscape(const string& s) {
+    string out;
+    for (char c : s) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    return out;
+}
+
+// Grava o resumo da execução, uma linha por instância (".json" gera JSON; outra extensão, CSV)
+inline bool writeRunSummary(const string& path, const vector<InstanceStats>& rows) {
+    ofstream out(path);
+    if (!out.is_open()) {
+        cerr << "Erro ao criar arquivo de resumo em: " << path << endl;
+        return false;
+    }
+    bool json = path.size() >= 5 && path.substr(path.size() - 5) == ".json";
+    if (json) {
+        out << "[" << endl;
+        for (size_t i = 0; i < rows.size(); ++i) {
+            const InstanceStats& r = rows[i];
+            out << "  {\"instance\": \"" << jsonEscape(r.instance) << "\", \"status\": \"" << (r.ok ? "ok" : "falha")
+                << "\", \"cost\": " << r.cost << ", \"routes\": " << r.routes
+                << ", \"parse_us\": " << r.parseTime << ", \"apsp_us\": " << r.apspTime
+                << ", \"construction_us\": " << r.constructionTime << ", \"local_search_us\": " << r.localSearchTime
+                << ", \"process_peak_rss_kb\": " << r.processPeakRssKb << "}" << (i + 1 < rows.size() ? "," : "") << endl;
+        }
+        out << "]" << endl;
+    } else {
+        out << "instance,status,cost,routes,parse_us,apsp_us,construction_us,local_search_us,process_peak_rss_kb" << endl;
+        for (const InstanceStats& r : rows) {
+            out << r.instance << "," << (r.ok ? "ok" : "falha") << "," << r.cost << "," << r.routes << ","
+                << r.parseTime << "," << r.apspTime << "," << r.constructionTime << "," << r.localSearchTime << ","
+                << r.processPeakRssKb << endl;
+        }
+    }
+    return true;
+}
+
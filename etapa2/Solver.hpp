@@ -55,6 +55,10 @@ private:
     // Gerador de números aleatórios
     mt19937 rng;
     
+    // Tempos das fases (microssegundos)
+    long long apspTimeMicroseconds = 0;
+    long long constructionTimeMicroseconds = 0;
+    
 public:
     Solver(Graph* g, int depotNode, int vehicleCapacity) 
         : graph(g), depot(depotNode), capacity(vehicleCapacity), rng(chrono::steady_clock::now().time_since_epoch().count()) {
@@ -73,9 +77,11 @@ public:
         
         // Calcula matriz de distâncias
         try {
+            auto apspStart = chrono::high_resolution_clock::now();
             auto [dist, pred] = graph->floydWarshall();
             distances = dist;
             predecessors = pred;
+            apspTimeMicroseconds = chrono::duration_cast<chrono::microseconds>(chrono::high_resolution_clock::now() - apspStart).count();
         } catch (const exception& e) {
             throw runtime_error("Failed to calculate shortest paths: " + string(e.what()));
         }
@@ -330,6 +336,7 @@ public:
         
         auto end = chrono::high_resolution_clock::now();
         auto duration = chrono::duration_cast<chrono::microseconds>(end - start);
+        constructionTimeMicroseconds = duration.count();
         
         // Cria o caminho completo para a pasta solucoes
         string solutionPath = "solucoes/" + filename;
@@ -383,7 +390,12 @@ public:
         cout << "Número de rotas: " << routes.size() << endl;
     }
     
+    // Define a semente do gerador de números aleatórios
+    void setSeed(unsigned seed) { rng.seed(seed); }
+    
     // Métodos de acesso
+    long long getApspTimeMicroseconds() const { return apspTimeMicroseconds; }
+    long long getConstructionTimeMicroseconds() const { return constructionTimeMicroseconds; }
     int getTotalCost() const { return totalCost; }
     int getNumRoutes() const { return routes.size(); }
     const vector<Route>& getRoutes() const { return routes; }
@@ -7,6 +7,8 @@
 #include <string>
 #include "Graph.hpp"
 #include "Solver.hpp"
+#include "Cli.hpp"
+#include "RunSummary.hpp"
 
 using namespace std;
 namespace fs = std::filesystem;
@@ -316,8 +318,8 @@ Solver* parseInputFile(const string& filename, Graph*& graph) {
     return solver;
 }
 
-// Função para processar um único arquivo
-bool processFile(const string& filename, int opcao) {
+// Função para processar um único arquivo; se 'stats' for informado, preenche os tempos e o resultado
+bool processFile(const string& filename, int opcao, InstanceStats* stats = nullptr, const CliOptions* options = nullptr) {
     cout << "\n" << string(60, '=') << endl;
     cout << "PROCESSANDO: " << filename << endl;
     cout << string(60, '=') << endl;
@@ -327,7 +329,9 @@ bool processFile(const string& filename, int opcao) {
     Solver* solver = nullptr;
     
     try {
+        auto parseStart = chrono::high_resolution_clock::now();
         solver = parseInputFile(inputPath, graph);
+        long long parseTime = chrono::duration_cast<chrono::microseconds>(chrono::high_resolution_clock::now() - parseStart).count();
         
         if (!graph || !solver) {
             cerr << "Erro: Falha ao processar " << filename << endl;
@@ -337,6 +341,9 @@ bool processFile(const string& filename, int opcao) {
         }
 
         string baseFilename = filename.substr(0, filename.find('.'));
+        if (options && options->hasSeed) {
+            solver->setSeed(options->seed);
+        }
         
         switch (opcao) {
             case 1:
@@ -383,6 +390,17 @@ bool processFile(const string& filename, int opcao) {
                 break;
         }
 
+        if (stats) {
+            // O Floyd-Warshall roda dentro da leitura (construtor do Solver); separa os dois tempos
+            stats->apspTime = solver->getApspTimeMicroseconds();
+            stats->parseTime = parseTime - stats->apspTime;
+            stats->constructionTime = solver->getConstructionTimeMicroseconds();
+            if (opcao == 2 || opcao == 3) {
+                stats->cost = solver->getTotalCost();
+                stats->routes = solver->getNumRoutes();
+            }
+        }
+
         // Cleanup
         delete graph;
         delete solver;
@@ -426,8 +444,54 @@ vector<string> getDatFiles(const string& folderPath) {
     return datFiles;
 }
 
-// Função principal
-int main() {
+// Executa um lote a partir das opções de linha de comando, sem menu interativo
+int runHeadless(int argc, char* argv[]) {
+    CliOptions options;
+    string error;
+    if (!parseCliOptions(argc, argv, options, error)) {
+        cerr << "ERRO: " << error << endl;
+        printUsage(argv[0]);
+        return 2;
+    }
+    if (options.help) {
+        printUsage(argv[0]);
+        return 0;
+    }
+    
+    try {
+        fs::create_directories("solucoes");
+    } catch (const exception& e) {
+        cerr << "Aviso: Erro ao criar pastas de saída: " << e.what() << endl;
+    }
+    
+    vector<string> datFiles = filterInstances(getDatFiles("entradas"), options.instancePatterns);
+    if (datFiles.empty()) {
+        cerr << "Nenhuma instância corresponde aos padrões informados na pasta 'entradas'" << endl;
+        return 1;
+    }
+    
+    vector<InstanceStats> stats = runBatch(datFiles, options.threads, [&](const string& filename, InstanceStats& row) {
+        return processFile(filename, options.mode, &row, &options);
+    });
+    writeRunSummary(options.summaryPath, stats);
+    
+    int falhas = count_if(stats.begin(), stats.end(), [](const InstanceStats& s) { return !s.ok; });
+    cout << "\n" << string(60, '=') << endl;
+    cout << "RESUMO DO PROCESSAMENTO EM LOTE" << endl;
+    cout << string(60, '=') << endl;
+    cout << "Total de arquivos: " << datFiles.size() << endl;
+    cout << "Sucessos: " << (datFiles.size() - falhas) << endl;
+    cout << "Falhas: " << falhas << endl;
+    cout << "Resumo gravado em: " << options.summaryPath << endl;
+    return falhas == 0 ? 0 : 1;
+}
+
+// Função principal: sem argumentos abre o menu interativo; com argumentos roda em modo headless
+int main(int argc, char* argv[]) {
+    if (argc > 1) {
+        return runHeadless(argc, argv);
+    }
+    
     cout << "=== PROCESSADOR DE ARQUIVOS CARP ===" << endl;
     cout << "\nEscolha uma opção:" << endl;
     cout << "1 - Processar arquivo específico" << endl;
@@ -0,0 +1,61 @@
+#ifndef CAPACITY_INDEX_HPP
+#define CAPACITY_INDEX_HPP
+
+#include <vector>
+#include <climits>
+#include <algorithm>
+
+using namespace std;
+
+/**
+ * @class CapacityIndex
+ * @brief Árvore de segmentos sobre os índices das rotas que guarda a maior capacidade residual
+ * de cada intervalo. Enumera, em ordem crescente de índice, as rotas com residual de pelo menos
+ * 'demand' em O((F + 1) log R), sem visitar as rotas que não comportam o serviço.
+ * Rotas removidas recebem residual INT_MIN e nunca são enumeradas.
+ */
+class CapacityIndex {
+private:
+    size_t leaves = 1;
+    vector<int> tree; // tree[1] é a raiz; as folhas começam em 'leaves'
+
+    template <typename Visit>
+    bool visit(size_t node, int demand, Visit& callback) const {
+        if (tree[node] < demand) return false;
+        if (node >= leaves) return callback(node - leaves);
+        return visit(2 * node, demand, callback) || visit(2 * node + 1, demand, callback);
+    }
+
+public:
+    /**
+     * @brief Monta o índice com o residual de cada rota.
+     */
+    void build(const vector<int>& residual) {
+        leaves = 1;
+        while (leaves < residual.size()) leaves *= 2;
+        tree.assign(2 * leaves, INT_MIN);
+        for (size_t r = 0; r < residual.size(); ++r) tree[leaves + r] = residual[r];
+        for (size_t node = leaves - 1; node >= 1; --node) tree[node] = max(tree[2 * node], tree[2 * node + 1]);
+    }
+
+    /**
+     * @brief Atualiza o residual de uma rota em O(log R).
+     */
+    void update(size_t route, int residual) {
+        size_t node = leaves + route;
+        tree[node] = residual;
+        for (node /= 2; node >= 1; node /= 2) tree[node] = max(tree[2 * node], tree[2 * node + 1]);
+    }
+
+    /**
+     * @brief Chama callback(r) para cada rota com residual >= demand, em ordem crescente de índice,
+     * até que o callback retorne true.
+     * @return True se algum callback interrompeu a enumeração.
+     */
+    template <typename Visit>
+    bool forEachWithResidual(int demand, Visit callback) const {
+        return !tree.empty() && visit(1, demand, callback);
+    }
+};
+
+#endif
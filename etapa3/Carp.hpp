@@ -0,0 +1,17 @@
+#ifndef CARP_HPP
+#define CARP_HPP
+
+#include "Solution.hpp"
+#include "Solver.hpp"
+#include "Instance.hpp"
+
+/**
+ * @brief API da biblioteca (libcarp.a): resolve uma instância em memória, sem acesso ao sistema de arquivos.
+ * @param instance A instância (serviços e ligações da rede).
+ * @param config Parâmetros do solver; use verbose = false para não imprimir o progresso.
+ * @return A solução encontrada; totalCost == INF indica que não há solução viável.
+ * @throws invalid_argument se a instância for inválida.
+ */
+Solution solveInstance(const Instance& instance, const SolverConfig& config = SolverConfig());
+
+#endif
@@ -0,0 +1,213 @@
+#ifndef CLI_HPP
+#define CLI_HPP
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <sstream>
+#include <thread>
+#include <algorithm>
+#include "Solver.hpp"
+#include "Parser.hpp"
+#include "ResultCache.hpp"
+#include "Pipeline.hpp"
+#include "RunSummary.hpp"
+
+using namespace std;
+
+/**
+ * @struct CliOptions
+ * @brief Opções da execução sem menu interativo (modo headless).
+ */
+struct CliOptions {
+    vector<string> instancePatterns;   // Nomes ou padrões (*, ?) de arquivos da pasta 'entradas'
+    int mode = 2;                      // 1: Estatísticas, 2: Solução, 3: Ambos
+    int threads = max(1u, thread::hardware_concurrency());
+    SolverConfig solver;
+    string summaryPath = "resumo.csv";
+    bool incremental = false;
+    bool help = false;
+};
+
+/**
+ * @brief Imprime a ajuda das opções de linha de comando.
+ */
+inline void printUsage(const string& program) {
+    cout << "Uso: " << program << " [opções]\n"
+         << "  Sem opções, o programa abre o menu interativo.\n\n"
+         << "  --instances <lista>   Arquivos de 'entradas', separados por vírgula; aceita * e ? (padrão: todos)\n"
+         << "  --mode <1|2|3>        1: estatísticas, 2: solução, 3: ambos (padrão: 2)\n"
+         << "  --threads <n>         Instâncias otimizadas em paralelo (padrão: núcleos disponíveis)\n"
+         << "  --seed <n>            Semente dos componentes aleatórios (padrão: 0)\n"
+         << "  --time-limit <s>      Orçamento de tempo por instância, em segundos, da busca escolhida em --metaheuristic (e da decomposição) (padrão: sem limite)\n"
+         << "  --iterations <n>      Orçamento de iterações por instância da busca escolhida em --metaheuristic (padrão: sem limite)\n"
+         << "  --constructor <nome>  Heurística construtiva: uma-rota, path-scanning, path-scanning-aleatorio ou savings (padrão: path-scanning)\n"
+         << "  --neighbours <k>      Vizinhança granular: k serviços mais próximos (padrão: 0, vizinhança completa)\n"
+         << "  --best-improvement    Aplica o melhor movimento de cada vizinhança (padrão: primeiro que melhora)\n"
+         << "  --search-threads <n>  Threads por instância: executam as partidas do multi-start, os filhos do memético ou avaliam as vizinhanças com --best-improvement (padrão: 1)\n"
+         << "  --starts <n>          Partidas independentes por instância, com sementes seed, seed+1, ... (padrão: 1)\n"
+         << "  --abandon-gap <f>     Abandona a partida pior que a melhor conhecida por mais que esta fração (padrão: 0.05; 0 = nunca)\n"
+         << "  --metaheuristic <m>   Busca após o primeiro ótimo local: ils, memetico, tabu, recozimento ou alns (padrão: ils)\n"
+         << "  --population <n>      Memético: tamanho da população (padrão: 20)\n"
+         << "  --clusters <n>        Decompõe a instância em n grupos resolvidos em paralelo (padrão: 0, sem decomposição)\n"
+         << "  --decomposition <d>   Agrupamento da decomposição: proximidade ou setores (padrão: proximidade)\n"
+         << "  --warm-start          Parte da solução salva em 'solucoes' (quando válida), em vez da construtiva\n"
+         << "  --summary <arquivo>   Resumo por instância; .json gera JSON, outra extensão gera CSV (padrão: resumo.csv)\n"
+         << "  --incremental         Pula instâncias cuja solução salva ainda corresponde à entrada e à configuração\n"
+         << "  --help                Mostra esta ajuda" << endl;
+}
+
+/**
+ * @brief Compara um nome com um padrão contendo os curingas '*' e '?'.
+ */
+inline bool wildcardMatch(const string& pattern, const string& text) {
+    size_t p = 0, t = 0, star = string::npos, mark = 0;
+    while (t < text.size()) {
+        if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == text[t])) { ++p; ++t; }
+        else if (p < pattern.size() && pattern[p] == '*') { star = p++; mark = t; }
+        else if (star != string::npos) { p = star + 1; t = ++mark; }
+        else return false;
+    }
+    while (p < pattern.size() && pattern[p] == '*') ++p;
+    return p == pattern.size();
+}
+
+/**
+ * @brief Lê as opções de linha de comando.
+ * @return False se alguma opção for inválida; a mensagem é devolvida em 'error'.
+ */
+inline bool parseCliOptions(int argc, char* argv[], CliOptions& options, string& error) {
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        auto value = [&]() -> string {
+            if (i + 1 >= argc) throw invalid_argument("a opção " + arg + " exige um valor");
+            return argv[++i];
+        };
+        try {
+            if (arg == "--help" || arg == "-h") options.help = true;
+            else if (arg == "--incremental") options.incremental = true;
+            else if (arg == "--instances") {
+                stringstream ss(value());
+                string item;
+                while (getline(ss, item, ',')) if (!item.empty()) options.instancePatterns.push_back(item);
+            }
+            else if (arg == "--mode") options.mode = stoi(value());
+            else if (arg == "--threads") options.threads = stoi(value());
+            else if (arg == "--seed") options.solver.seed = stoul(value());
+            else if (arg == "--time-limit") options.solver.timeLimitSeconds = stod(value());
+            else if (arg == "--neighbours") options.solver.neighbours = stoi(value());
+            else if (arg == "--best-improvement") options.solver.bestImprovement = true;
+            else if (arg == "--search-threads") options.solver.searchThreads = stoi(value());
+            else if (arg == "--iterations") options.solver.maxIterations = stoll(value());
+            else if (arg == "--starts") options.solver.starts = stoi(value());
+            else if (arg == "--abandon-gap") options.solver.abandonGap = stod(value());
+            else if (arg == "--constructor") {
+                string name = value();
+                if (!parseConstruction(name, options.solver.construction)) { error = "heurística construtiva desconhecida: " + name; return false; }
+            }
+            else if (arg == "--metaheuristic") {
+                string name = value();
+                if (!parseMetaheuristic(name, options.solver.metaheuristic)) { error = "metaheurística desconhecida: " + name; return false; }
+            }
+            else if (arg == "--population") options.solver.population = stoi(value());
+            else if (arg == "--clusters") options.solver.clusters = stoi(value());
+            else if (arg == "--decomposition") {
+                string name = value();
+                if (!parseDecomposition(name, options.solver.decomposition)) { error = "decomposição desconhecida: " + name; return false; }
+            }
+            else if (arg == "--warm-start") options.solver.warmStart = true;
+            else if (arg == "--summary") options.summaryPath = value();
+            else { error = "opção desconhecida: " + arg; return false; }
+        } catch (const exception& e) {
+            error = "valor inválido para " + arg + " (" + e.what() + ")";
+            return false;
+        }
+    }
+    if (options.mode < 1 || options.mode > 3) { error = "--mode deve ser 1, 2 ou 3"; return false; }
+    if (options.threads < 1) { error = "--threads deve ser positivo"; return false; }
+    if (options.solver.neighbours < 0) { error = "--neighbours não pode ser negativo"; return false; }
+    if (options.solver.searchThreads < 1) { error = "--search-threads deve ser positivo"; return false; }
+    if (options.solver.maxIterations < 0) { error = "--iterations não pode ser negativo"; return false; }
+    if (options.solver.starts < 1) { error = "--starts deve ser positivo"; return false; }
+    if (options.solver.abandonGap < 0) { error = "--abandon-gap não pode ser negativo"; return false; }
+    if (options.solver.population < 2) { error = "--population deve ser pelo menos 2"; return false; }
+    if (options.solver.clusters < 0) { error = "--clusters não pode ser negativo"; return false; }
+    if (options.solver.timeLimitSeconds < 0) { error = "--time-limit não pode ser negativo"; return false; }
+    return true;
+}
+
+/**
+ * @brief Seleciona os arquivos de 'entradas' que correspondem a algum dos padrões, sem repetição.
+ */
+inline vector<string> resolveInstances(const vector<string>& patterns) {
+    vector<string> available = getDatFiles("entradas");
+    if (patterns.empty()) return available;
+    vector<string> selected;
+    for (const auto& filename : available) {
+        for (const auto& pattern : patterns) {
+            if (wildcardMatch(fs::path(pattern).filename().string(), filename)) {
+                selected.push_back(filename);
+                break;
+            }
+        }
+    }
+    return selected;
+}
+
+/**
+ * @brief Executa um lote sem menu interativo e grava o resumo por instância.
+ * @return O código de saída do programa (0 se todas as instâncias foram processadas com sucesso).
+ */
+inline int runHeadless(int argc, char* argv[]) {
+    CliOptions options;
+    string error;
+    if (!parseCliOptions(argc, argv, options, error)) {
+        cerr << "ERRO: " << error << endl;
+        printUsage(argv[0]);
+        return 2;
+    }
+    if (options.help) {
+        printUsage(argv[0]);
+        return 0;
+    }
+
+    try {
+        fs::create_directories("solucoes");
+    } catch (const exception& e) {
+        cerr << "Aviso: Erro ao criar pastas de saída: " << e.what() << endl;
+    }
+
+    vector<string> files = resolveInstances(options.instancePatterns);
+    if (files.empty()) {
+        cerr << "Nenhuma instância corresponde aos padrões informados na pasta 'entradas'" << endl;
+        return 1;
+    }
+    int pulados = 0;
+    if (options.incremental && options.mode != 1) {
+        ResultCache cache;
+        vector<string> changed;
+        for (const auto& filename : files) {
+            if (cache.isUpToDate(filename, cacheSignature(options.solver, filename))) pulados++;
+            else changed.push_back(filename);
+        }
+        files = changed;
+    }
+
+    PipelineConfig config;
+    config.solvers = options.threads;
+    config.solverConfig = options.solver;
+    PipelineResult result = runPipeline(files, options.mode, config);
+    writeRunSummary(options.summaryPath, result.stats);
+
+    cout << "\n" << string(60, '=') << endl;
+    cout << "RESUMO DO PROCESSAMENTO EM LOTE" << endl;
+    cout << string(60, '=') << endl;
+    cout << "Total de arquivos processados: " << (files.size() + pulados) << endl;
+    cout << "  - Sucessos: " << result.sucessos << endl;
+    cout << "  - Falhas: " << result.falhas << endl;
+    if (options.incremental) cout << "  - Pulados (inalterados): " << pulados << endl;
+    cout << "Resumo gravado em: " << options.summaryPath << endl;
+    return result.falhas == 0 ? 0 : 1;
+}
+
+#endif
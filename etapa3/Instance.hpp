@@ -0,0 +1,97 @@
+#ifndef INSTANCE_HPP
+#define INSTANCE_HPP
+
+#include <vector>
+#include <string>
+#include <stdexcept>
+#include "Graph.hpp"
+#include "Solver.hpp"
+
+using namespace std;
+
+/**
+ * @struct InstanceService
+ * @brief Um serviço obrigatório de uma instância em memória (nós com índice base 0).
+ * Para nós ('N'), u == v e travelCost é ignorado.
+ */
+struct InstanceService {
+    char type;        // 'N' (nó), 'E' (aresta) ou 'A' (arco)
+    int u, v;
+    int demand;
+    int serviceCost;
+    int travelCost;
+};
+
+/**
+ * @struct InstanceEdge
+ * @brief Uma ligação da rede (nós com índice base 0). Deve incluir também as arestas/arcos requeridos.
+ */
+struct InstanceEdge {
+    int u, v;
+    int cost;
+    bool directed;
+};
+
+/**
+ * @struct Instance
+ * @brief Uma instância completa do problema, construída em memória, sem arquivo .dat.
+ * Os serviços recebem ids 1..n na ordem do vetor, como no arquivo de entrada.
+ */
+struct Instance {
+    string name = "memoria";
+    int numNodes = 0;
+    int depot = 0;
+    int capacity = 0;
+    long long optimalValue = -1;
+    vector<InstanceService> services;
+    vector<InstanceEdge> edges;
+};
+
+/**
+ * @brief Constrói o grafo e o solver de uma instância em memória.
+ * @param instance A instância.
+ * @param graph Referência a um ponteiro de Graph que será alocado (pertence ao chamador).
+ * @return Um ponteiro para um Solver inicializado (pertence ao chamador).
+ * @throws invalid_argument se o depósito, a capacidade ou algum nó, custo ou demanda for inválido.
+ */
+inline Solver* createSolver(const Instance& instance, Graph*& graph) {
+    auto validNode = [&](int node) { return node >= 0 && node < instance.numNodes; };
+    if (!validNode(instance.depot)) {
+        throw invalid_argument("Depósito inválido na instância " + instance.name + ".");
+    }
+    if (instance.capacity <= 0) {
+        throw invalid_argument("Capacidade inválida na instância " + instance.name + ".");
+    }
+    for (const auto& edge : instance.edges) {
+        if (!validNode(edge.u) || !validNode(edge.v) || edge.cost < 0) {
+            throw invalid_argument("Ligação inválida na instância " + instance.name + ".");
+        }
+    }
+    for (const auto& service : instance.services) {
+        if (!validNode(service.u) || !validNode(service.v) || service.demand < 0 ||
+            (service.type != 'N' && service.type != 'E' && service.type != 'A')) {
+            throw invalid_argument("Serviço inválido na instância " + instance.name + ".");
+        }
+    }
+
+    graph = new Graph(instance.numNodes);
+    try {
+        for (const auto& edge : instance.edges) {
+            graph->addEdge(edge.u, edge.v, edge.cost, edge.directed);
+        }
+        Solver* solver = new Solver(graph, instance.depot, instance.capacity, instance.name);
+        solver->setOptimalValue(instance.optimalValue);
+        int serviceId = 1;
+        for (const auto& service : instance.services) {
+            solver->addService(serviceId++, service.type, service.u, service.v, service.demand, service.serviceCost,
+                               service.type == 'N' ? 0 : service.travelCost);
+        }
+        return solver;
+    } catch (...) {
+        delete graph;
+        graph = nullptr;
+        throw;
+    }
+}
+
+#endif
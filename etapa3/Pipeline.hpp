@@ -0,0 +1,231 @@
+#ifndef PIPELINE_HPP
+#define PIPELINE_HPP
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <queue>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <algorithm>
+#include "Graph.hpp"
+#include "Solver.hpp"
+#include "Parser.hpp"
+#include "ResultCache.hpp"
+#include "RunSummary.hpp"
+
+using namespace std;
+
+/**
+ * @class BoundedQueue
+ * @brief Fila bloqueante de capacidade limitada que liga dois estágios do pipeline.
+ * push() bloqueia enquanto a fila está cheia; pop() bloqueia enquanto está vazia e retorna
+ * false quando a fila foi fechada e não há mais itens.
+ */
+template <typename T>
+class BoundedQueue {
+private:
+    queue<T> items;
+    size_t capacity;
+    bool closed = false;
+    mutex mtx;
+    condition_variable notFull, notEmpty;
+
+public:
+    explicit BoundedQueue(size_t maxItems) : capacity(max<size_t>(1, maxItems)) {}
+
+    void push(T item) {
+        unique_lock<mutex> lock(mtx);
+        notFull.wait(lock, [&]{ return items.size() < capacity || closed; });
+        if (closed) return;
+        items.push(move(item));
+        notEmpty.notify_one();
+    }
+
+    bool pop(T& item) {
+        unique_lock<mutex> lock(mtx);
+        notEmpty.wait(lock, [&]{ return !items.empty() || closed; });
+        if (items.empty()) return false;
+        item = move(items.front());
+        items.pop();
+        notFull.notify_one();
+        return true;
+    }
+
+    /**
+     * @brief Sinaliza que nenhum item novo será inserido, liberando os consumidores bloqueados.
+     */
+    void close() {
+        lock_guard<mutex> lock(mtx);
+        closed = true;
+        notEmpty.notify_all();
+        notFull.notify_all();
+    }
+};
+
+/**
+ * @struct PipelineJob
+ * @brief Uma instância em trânsito pelo pipeline; pertence a um único estágio por vez.
+ */
+struct PipelineJob {
+    size_t index;
+    string filename;
+    unique_ptr<Graph> graph;
+    unique_ptr<Solver> solver;
+    Solution solution;
+    InstanceStats stats;
+    string signature; // Assinatura do cache de resultados (ver cacheSignature)
+};
+
+/**
+ * @struct PipelineConfig
+ * @brief Número de threads de cada estágio e tamanho das filas entre eles.
+ */
+struct PipelineConfig {
+    int readers = 1;
+    int apspWorkers = 1;
+    int solvers = max(1u, thread::hardware_concurrency());
+    int writers = 1;
+    size_t queueSize = 4;
+    SolverConfig solverConfig;
+};
+
+/**
+ * @struct PipelineResult
+ * @brief Contadores do processamento em lote e estatísticas de cada instância, na ordem da entrada.
+ */
+struct PipelineResult {
+    int sucessos = 0;
+    int falhas = 0;
+    vector<InstanceStats> stats;
+};
+
+/**
+ * @brief Assinatura com que o cache de resultados registra a solução de uma instância: a configuração
+ * do solver e, com partida a quente, o hash da solução de partida. Como cada execução regrava a
+ * solução, com --warm-start o modo incremental só pula uma instância cuja solução salva não mudou
+ * desde que serviu de partida; na prática, toda execução volta a partir da melhor solução salva.
+ */
+inline string cacheSignature(const SolverConfig& config, const string& filename) {
+    string signature = Solver::configSignature(config);
+    if (config.warmStart) signature += ";inicio=" + ResultCache().solutionHash(filename);
+    return signature;
+}
+
+/**
+ * @brief Inicia as threads de um estágio: cada uma consome da fila de entrada, aplica 'work' e,
+ * se o resultado não for nulo, o repassa à fila de saída. A última thread a terminar fecha a saída.
+ */
+template <typename Work>
+void launchStage(vector<thread>& threads, int workers, BoundedQueue<unique_ptr<PipelineJob>>& in,
+                 BoundedQueue<unique_ptr<PipelineJob>>* out, Work work) {
+    auto remaining = make_shared<atomic<int>>(max(1, workers));
+    for (int i = 0; i < max(1, workers); ++i) {
+        threads.emplace_back([&in, out, work, remaining]() {
+            unique_ptr<PipelineJob> job;
+            while (in.pop(job)) {
+                if (work(*job) && out) out->push(move(job));
+                job.reset();
+            }
+            if (--*remaining == 0 && out) out->close();
+        });
+    }
+}
+
+/**
+ * @brief Processa um lote de instâncias num pipeline de quatro estágios ligados por filas limitadas:
+ * leitura -> distâncias mínimas (Floyd-Warshall) -> otimização -> escrita.
+ * Assim, a instância N+1 é lida e tem suas distâncias calculadas enquanto a instância N é otimizada.
+ * @param files Os nomes dos arquivos da pasta 'entradas' a processar.
+ * @param opcao O tipo de operação (1: Estatísticas, 2: Solução, 3: Ambos).
+ * @param config A concorrência de cada estágio e a configuração do solver.
+ * @return Os contadores de sucesso e falha e as estatísticas por instância.
+ */
+inline PipelineResult runPipeline(const vector<string>& files, int opcao, const PipelineConfig& config) {
+    bool solve = (opcao == 2 || opcao == 3);
+    BoundedQueue<unique_ptr<PipelineJob>> toRead(files.size() + 1), toApsp(config.queueSize),
+        toSolve(config.queueSize), toWrite(config.queueSize);
+    vector<InstanceStats> stats(files.size());
+    vector<thread> threads;
+    mutex statsMutex;
+    auto finish = [&](PipelineJob& job, bool ok) {
+        job.stats.ok = ok;
+        job.stats.processPeakRssKb = peakRssKb();
+        lock_guard<mutex> lock(statsMutex);
+        stats[job.index] = job.stats;
+    };
+
+    launchStage(threads, config.readers, toRead, &toApsp, [&](PipelineJob& job) {
+        auto start = chrono::steady_clock::now();
+        Graph* graph = nullptr;
+        job.solver.reset(parseInputFile("entradas/" + job.filename, graph));
+        job.graph.reset(graph);
+        job.stats.parseTime = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+        if (!job.solver) {
+            cerr << "ERRO: Falha ao inicializar o problema a partir de " << job.filename << "." << endl;
+            finish(job, false);
+            return false;
+        }
+        job.solver->setConfig(config.solverConfig);
+        if (!solve) finish(job, true);
+        return solve;
+    });
+    launchStage(threads, config.apspWorkers, toApsp, &toSolve, [](PipelineJob& job) {
+        job.solver->precomputeDistances();
+        job.stats.apspTime = job.solver->getApspTimeMicroseconds();
+        return true;
+    });
+    launchStage(threads, config.solvers, toSolve, &toWrite, [&](PipelineJob& job) {
+        try {
+            job.signature = cacheSignature(config.solverConfig, job.filename);
+            if (config.solverConfig.warmStart) {
+                Solution initial;
+                string error;
+                if (job.solver->loadSolution("solucoes/sol-" + job.filename, initial, error)) job.solver->setWarmStart(initial);
+                else cerr << "Aviso [" << job.filename << "]: partida a quente ignorada (" << error << ")" << endl;
+            }
+            job.solution = job.solver->solve();
+            job.stats.constructionTime = job.solution.constructionTimeMicroseconds;
+            job.stats.localSearchTime = job.solution.localSearchTimeMicroseconds;
+            job.stats.lowerBound = job.solver->getLowerBound();
+            job.stats.vehicleBound = job.solver->getVehicleBound();
+            return true;
+        } catch (const exception& e) {
+            cerr << "✗ Erro geral ao processar " << job.filename << ": " << e.what() << endl;
+            finish(job, false);
+            return false;
+        }
+    });
+    launchStage(threads, config.writers, toWrite, nullptr, [&](PipelineJob& job) {
+        job.solver->saveSolution(job.solution, job.filename);
+        ResultCache().record(job.filename, job.signature);
+        bool feasible = job.solution.totalCost < INF;
+        job.stats.cost = feasible ? job.solution.totalCost : -1;
+        job.stats.routes = job.solution.routes.size();
+        finish(job, feasible);
+        return true;
+    });
+
+    for (size_t i = 0; i < files.size(); ++i) {
+        auto job = make_unique<PipelineJob>();
+        job->index = i;
+        job->filename = files[i];
+        toRead.push(move(job));
+    }
+    toRead.close();
+    for (auto& t : threads) t.join();
+
+    PipelineResult result;
+    for (size_t i = 0; i < files.size(); ++i) {
+        stats[i].instance = files[i];
+        if (stats[i].ok) result.sucessos++;
+        else result.falhas++;
+    }
+    result.stats = stats;
+    return result;
+}
+
+#endif
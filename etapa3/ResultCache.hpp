@@ -0,0 +1,116 @@
+#ifndef RESULT_CACHE_HPP
+#define RESULT_CACHE_HPP
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <filesystem>
+#include <string>
+#include <cstdint>
+
+using namespace std;
+namespace fs = std::filesystem;
+
+/**
+ * @brief Hash FNV-1a de 64 bits de uma sequência de bytes.
+ * @param data Os bytes a serem processados.
+ * @param hash Valor inicial, permitindo encadear várias chamadas.
+ */
+inline uint64_t fnv1a(const string& data, uint64_t hash = 14695981039346656037ULL) {
+    for (unsigned char c : data) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+/**
+ * @brief Formata um hash de 64 bits como 16 dígitos hexadecimais.
+ */
+inline string hashToHex(uint64_t hash) {
+    stringstream ss;
+    ss << hex << setw(16) << setfill('0') << hash;
+    return ss.str();
+}
+
+/**
+ * @class ResultCache
+ * @brief Cache de resultados do processamento em lote.
+ * Ao lado de cada sol-<instancia> grava um arquivo sol-<instancia>.hash com o hash do conteúdo
+ * da instância e da configuração do solver (incluindo a versão). Numa nova execução incremental,
+ * instâncias cujo hash não mudou são puladas.
+ */
+class ResultCache {
+private:
+    string inputDir;
+    string solutionDir;
+
+    string solutionPath(const string& filename) const { return solutionDir + "/sol-" + filename; }
+    string hashPath(const string& filename) const { return solutionPath(filename) + ".hash"; }
+
+    /**
+     * @brief Calcula o hash do conteúdo do arquivo de instância.
+     * @return O hash em hexadecimal, ou string vazia se o arquivo não puder ser lido.
+     */
+    string instanceHash(const string& filename) const {
+        ifstream in(inputDir + "/" + filename, ios::binary);
+        if (!in.is_open()) return "";
+        stringstream content;
+        content << in.rdbuf();
+        return hashToHex(fnv1a(content.str()));
+    }
+
+public:
+    /**
+     * @brief Hash do conteúdo da solução salva de uma instância (ou string vazia, se não houver),
+     * usado para identificar a solução de partida de uma execução com partida a quente.
+     */
+    string solutionHash(const string& filename) const {
+        ifstream in(solutionPath(filename), ios::binary);
+        if (!in.is_open()) return "";
+        stringstream content;
+        content << in.rdbuf();
+        return hashToHex(fnv1a(content.str()));
+    }
+
+    ResultCache(const string& inputFolder = "entradas", const string& solutionFolder = "solucoes")
+        : inputDir(inputFolder), solutionDir(solutionFolder) {}
+
+    /**
+     * @brief Verifica se a solução salva de uma instância ainda é válida para a configuração atual.
+     * @param filename O nome do arquivo de instância.
+     * @param configSignature Descrição textual da configuração e versão do solver.
+     * @return True se a solução existe e foi gerada a partir da mesma instância e configuração.
+     */
+    bool isUpToDate(const string& filename, const string& configSignature) const {
+        if (!fs::exists(solutionPath(filename))) return false;
+        ifstream in(hashPath(filename));
+        if (!in.is_open()) return false;
+        string instance, config;
+        getline(in, instance);
+        getline(in, config);
+        string current = instanceHash(filename);
+        return !current.empty() && instance == "instancia=" + current &&
+               config == "configuracao=" + hashToHex(fnv1a(configSignature));
+    }
+
+    /**
+     * @brief Registra os hashes da instância e da configuração usados para gerar a solução salva.
+     */
+    void record(const string& filename, const string& configSignature) const {
+        if (!fs::exists(solutionPath(filename))) return;
+        string current = instanceHash(filename);
+        if (current.empty()) return;
+        ofstream out(hashPath(filename));
+        if (!out.is_open()) {
+            cerr << "Aviso: não foi possível gravar " << hashPath(filename) << endl;
+            return;
+        }
+        out << "instancia=" << current << endl;
+        out << "configuracao=" << hashToHex(fnv1a(configSignature)) << endl;
+        out << configSignature << endl;
+    }
+};
+
+#endif
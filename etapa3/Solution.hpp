@@ -3,6 +3,8 @@
 
 #include <vector>
 #include <string>
+#include <memory>
+#include <cstdint>
 
 using namespace std;
 
@@ -23,14 +25,57 @@ struct Service {
         : id(_id), type(_type), u(_u), v(_v), demand(_demand), serviceCost(_serviceCost), travelCost(_travelCost) {}
 };
 
+// Bit mais alto de uma visita na rota: a aresta ('E') é percorrida no sentido v -> u.
+const uint32_t REVERSED_VISIT = 0x80000000u;
+
+/**
+ * @brief Índice na ServiceTable do serviço de uma visita, sem o bit de sentido.
+ */
+inline uint32_t serviceOf(uint32_t visit) { return visit & ~REVERSED_VISIT; }
+
+/**
+ * @struct ServiceTable
+ * @brief Tabela imutável de serviços em formato de estrutura de vetores (SoA).
+ * As rotas guardam apenas o índice (32 bits) de cada serviço nesta tabela, o que reduz a
+ * memória tocada e o custo das cópias durante a busca local.
+ */
+struct ServiceTable {
+    vector<int> id;
+    vector<char> type;
+    vector<int> u, v;
+    vector<int> demand;
+    vector<long long> cost; // Custo fixo na rota: atendimento + travessia (arestas/arcos)
+
+    size_t size() const { return id.size(); }
+
+    // Nós em que a visita começa e termina, respeitando o sentido de percurso
+    int startOf(uint32_t visit) const { return visit & REVERSED_VISIT ? v[serviceOf(visit)] : u[serviceOf(visit)]; }
+    int endOf(uint32_t visit) const { return visit & REVERSED_VISIT ? u[serviceOf(visit)] : v[serviceOf(visit)]; }
+
+    /**
+     * @brief A mesma visita percorrida no sentido oposto; só arestas ('E') podem ser invertidas.
+     */
+    uint32_t reversed(uint32_t visit) const { return type[serviceOf(visit)] == 'E' ? visit ^ REVERSED_VISIT : visit; }
+
+    void add(const Service& service) {
+        id.push_back(service.id);
+        type.push_back(service.type);
+        u.push_back(service.u);
+        v.push_back(service.v);
+        demand.push_back(service.demand);
+        cost.push_back(service.serviceCost + (service.type != 'N' ? service.travelCost : 0));
+    }
+};
+
 /**
  * @struct Route
  * @brief Representa a rota de um único veículo.
- * Contém uma sequência de serviços, a demanda total e o custo total da rota.
+ * Contém a sequência de visitas (índices na ServiceTable, com o bit REVERSED_VISIT quando uma aresta
+ * é percorrida de v para u), a demanda total e o custo total da rota.
  */
 struct Route { 
     int id; 
-    vector<Service> services; 
+    vector<uint32_t> services; 
     int totalDemand = 0; 
     long long totalCost = 0; 
 };
@@ -38,12 +83,16 @@ struct Route {
 /**
  * @struct Solution
  * @brief Representa a solução completa para o problema.
- * Contém o custo total, o conjunto de todas as rotas e o tempo de execução.
+ * Contém o custo total, o conjunto de todas as rotas, a tabela de serviços e o tempo de execução.
  */
 struct Solution { 
     long long totalCost = 0; 
     vector<Route> routes; 
+    shared_ptr<const ServiceTable> serviceTable; // Tabela à qual os índices das rotas se referem
     long long executionTimeMicroseconds = 0; 
+    long long bestTimeMicroseconds = 0; // Instante, desde o início de solve(), em que esta solução foi encontrada
+    long long constructionTimeMicroseconds = 0;
+    long long localSearchTimeMicroseconds = 0;
 };
 
 #endif
\ No newline at end of file
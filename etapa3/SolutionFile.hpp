@@ -0,0 +1,104 @@
+#ifndef SOLUTION_FILE_HPP
+#define SOLUTION_FILE_HPP
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include <string>
+
+using namespace std;
+
+/**
+ * @struct SolutionVisit
+ * @brief Uma visita lida de uma linha de rota: "(D 0,1,1)" ou "(S id,u,v)", com nós em base 1.
+ */
+struct SolutionVisit {
+    char type;
+    int serviceId;
+    int u, v;
+};
+
+/**
+ * @struct SolutionFileRoute
+ * @brief Uma linha de rota de um arquivo sol-*.dat, exatamente como foi escrita.
+ */
+struct SolutionFileRoute {
+    int id = 0;
+    int demand = 0;
+    long long cost = 0;
+    int visitCount = 0;
+    vector<SolutionVisit> visits;
+};
+
+/**
+ * @struct SolutionFile
+ * @brief Conteúdo de um arquivo sol-*.dat: cabeçalho de quatro linhas seguido das rotas.
+ */
+struct SolutionFile {
+    bool infeasible = false;
+    long long totalCost = 0;
+    int numRoutes = 0;
+    long long totalTime = 0;
+    long long bestTime = 0;
+    vector<SolutionFileRoute> routes;
+};
+
+/**
+ * @brief Lê um arquivo de solução no formato gerado por Solver::saveSolution.
+ * @param path Caminho do arquivo sol-*.dat.
+ * @param out Estrutura preenchida com o conteúdo lido.
+ * @param error Mensagem de erro, caso a leitura falhe.
+ * @return True se o arquivo foi lido com sucesso.
+ */
+inline bool readSolutionFile(const string& path, SolutionFile& out, string& error) {
+    ifstream in(path);
+    if (!in.is_open()) { error = "não foi possível abrir " + path; return false; }
+
+    string line;
+    if (!getline(in, line)) { error = "arquivo vazio"; return false; }
+    if (line.find("inviavel") != string::npos) { out.infeasible = true; return true; }
+
+    try {
+        out.totalCost = stoll(line);
+        if (!getline(in, line)) throw runtime_error("cabeçalho incompleto");
+        out.numRoutes = stoi(line);
+        if (!getline(in, line)) throw runtime_error("cabeçalho incompleto");
+        out.totalTime = stoll(line);
+        if (!getline(in, line)) throw runtime_error("cabeçalho incompleto");
+        out.bestTime = stoll(line);
+    } catch (const exception& e) {
+        error = string("cabeçalho inválido: ") + e.what();
+        return false;
+    }
+
+    while (getline(in, line)) {
+        if (line.find_first_not_of(" \t\r\n") == string::npos) continue;
+        SolutionFileRoute route;
+        int depotMark, day;
+        stringstream ss(line.substr(0, line.find('(')));
+        if (!(ss >> depotMark >> day >> route.id >> route.demand >> route.cost >> route.visitCount)) {
+            error = "linha de rota inválida: " + line;
+            return false;
+        }
+        size_t pos = line.find('(');
+        while (pos != string::npos) {
+            size_t close = line.find(')', pos);
+            if (close == string::npos) { error = "visita sem ')': " + line; return false; }
+            string item = line.substr(pos + 1, close - pos - 1);
+            for (auto& c : item) if (c == ',') c = ' ';
+            stringstream is(item);
+            SolutionVisit visit;
+            if (!(is >> visit.type >> visit.serviceId >> visit.u >> visit.v)) {
+                error = "visita inválida: (" + line.substr(pos + 1, close - pos - 1) + ")";
+                return false;
+            }
+            route.visits.push_back(visit);
+            pos = line.find('(', close);
+        }
+        out.routes.push_back(route);
+    }
+    return true;
+}
+
+#endif
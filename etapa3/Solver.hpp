@@ -3,12 +3,216 @@
 
 #include "Graph.hpp"
 #include "Solution.hpp"
+#include "ThreadPool.hpp"
+#include "CapacityIndex.hpp"
+#include "SolutionFile.hpp"
 #include <chrono>
 #include <random>
 #include <algorithm>
 #include <filesystem>
 #include <vector>
 #include <cmath>
+#include <tuple>
+#include <memory>
+#include <atomic>
+#include <deque>
+#include <queue>
+#include <unordered_map>
+
+// Versão do solver; deve ser alterada sempre que uma mudança no código puder alterar as soluções.
+const string SOLVER_VERSION = "3.5";
+
+/**
+ * @enum Construction
+ * @brief Heurística construtiva que gera a solução de partida da busca local.
+ */
+enum class Construction {
+    SingleServiceRoutes,  // Uma rota por serviço (Etapa 2)
+    PathScanning,         // Path-scanning com as cinco regras de desempate; fica a melhor das cinco
+    PathScanningRandom,   // Path-scanning com regra e desempates sorteados
+    Savings               // Economias de Clarke-Wright a partir de uma rota por serviço
+};
+
+/**
+ * @brief Nome da heurística construtiva, usado na linha de comando e na assinatura da configuração.
+ */
+inline string constructionName(Construction construction) {
+    switch (construction) {
+        case Construction::SingleServiceRoutes: return "uma-rota";
+        case Construction::PathScanning: return "path-scanning";
+        case Construction::PathScanningRandom: return "path-scanning-aleatorio";
+        case Construction::Savings: return "savings";
+    }
+    return "";
+}
+
+/**
+ * @brief Converte um nome de heurística construtiva; retorna false se o nome for desconhecido.
+ */
+inline bool parseConstruction(const string& name, Construction& construction) {
+    for (Construction c : {Construction::SingleServiceRoutes, Construction::PathScanning, Construction::PathScanningRandom, Construction::Savings}) {
+        if (constructionName(c) == name) { construction = c; return true; }
+    }
+    return false;
+}
+
+/**
+ * @enum Metaheuristic
+ * @brief Método que continua a busca depois do primeiro ótimo local.
+ */
+enum class Metaheuristic {
+    IteratedLocalSearch,  // Busca local iterada, com multi-start opcional
+    Memetic,              // Algoritmo memético: população de tours gigantes, OX, Split e busca local
+    Tabu,                 // Busca tabu sobre Relocate e Swap
+    Annealing,            // Recozimento simulado com movimentos aleatórios
+    Alns                  // Busca adaptativa em vizinhança grande (destruição e reparo)
+};
+
+/**
+ * @brief Nome da metaheurística, usado na linha de comando e na assinatura da configuração.
+ */
+inline string metaheuristicName(Metaheuristic metaheuristic) {
+    switch (metaheuristic) {
+        case Metaheuristic::IteratedLocalSearch: return "ils";
+        case Metaheuristic::Memetic: return "memetico";
+        case Metaheuristic::Tabu: return "tabu";
+        case Metaheuristic::Annealing: return "recozimento";
+        case Metaheuristic::Alns: return "alns";
+    }
+    return "";
+}
+
+/**
+ * @brief Converte um nome de metaheurística; retorna false se o nome for desconhecido.
+ */
+inline bool parseMetaheuristic(const string& name, Metaheuristic& metaheuristic) {
+    for (Metaheuristic m : {Metaheuristic::IteratedLocalSearch, Metaheuristic::Memetic, Metaheuristic::Tabu, Metaheuristic::Annealing, Metaheuristic::Alns}) {
+        if (metaheuristicName(m) == name) { metaheuristic = m; return true; }
+    }
+    return false;
+}
+
+/**
+ * @enum Decomposition
+ * @brief Critério de agrupamento dos serviços na decomposição da instância.
+ */
+enum class Decomposition {
+    Proximity,  // k-medoides pela distância mínima entre os extremos dos serviços
+    Sectors     // Setores em torno do depósito, com ângulos estimados a partir das distâncias
+};
+
+/**
+ * @brief Nome do critério de decomposição, usado na linha de comando e na assinatura da configuração.
+ */
+inline string decompositionName(Decomposition decomposition) {
+    return decomposition == Decomposition::Sectors ? "setores" : "proximidade";
+}
+
+/**
+ * @brief Converte um nome de critério de decomposição; retorna false se o nome for desconhecido.
+ */
+inline bool parseDecomposition(const string& name, Decomposition& decomposition) {
+    for (Decomposition d : {Decomposition::Proximity, Decomposition::Sectors}) {
+        if (decompositionName(d) == name) { decomposition = d; return true; }
+    }
+    return false;
+}
+
+/**
+ * @struct SolverConfig
+ * @brief Parâmetros de execução do solver.
+ */
+struct SolverConfig {
+    unsigned seed = 0;             // Semente dos componentes aleatórios
+    double timeLimitSeconds = 0;   // Limite de tempo por instância (0 = sem limite)
+    long long maxIterations = 0;   // Iterações da metaheurística (0 = sem limite de iterações)
+    Construction construction = Construction::PathScanning; // Heurística construtiva da solução de partida
+    bool verbose = true;           // Imprime o progresso (LOG) no terminal
+    int neighbours = 0;            // Vizinhança granular: k vizinhos mais próximos por serviço (0 = vizinhança completa)
+    bool bestImprovement = false;  // Aplica o melhor movimento de cada vizinhança em vez do primeiro que melhora
+    int searchThreads = 1;         // Threads por instância: executam as partidas do multi-start ou, com uma só
+                                   // partida, avaliam a vizinhança no modo de melhor melhoria
+    int starts = 1;                // Partidas independentes (multi-start), com sementes seed, seed+1, ...
+    double abandonGap = 0.05;      // Multi-start: abandona a partida cuja melhor é pior que a incumbente por mais
+                                   // que esta fração (0 = nunca abandona)
+    Metaheuristic metaheuristic = Metaheuristic::IteratedLocalSearch; // Busca depois do primeiro ótimo local
+    int population = 20;           // Memético: tamanho da população após a seleção de sobreviventes
+    int clusters = 0;              // Decomposição: número de subproblemas resolvidos separadamente (0 = sem decomposição)
+    Decomposition decomposition = Decomposition::Proximity; // Critério de agrupamento da decomposição
+    bool warmStart = false;        // Parte da solução já salva em solucoes/, quando ela existe e é válida
+};
+
+/**
+ * @struct SearchState
+ * @brief Índice auxiliar da busca local: a rota e a posição atuais de cada serviço.
+ * Permite às vizinhanças granulares localizar em O(1) onde está cada vizinho de um serviço.
+ *
+ * Também guarda os carimbos de alteração: 'version' é incrementada a cada rota alterada,
+ * routeStamp[r] é a versão da última alteração da rota r e changeLog[v - 1] é a rota alterada na
+ * versão v. Cada varredura sem melhoria registra a versão em que terminou (carimbo "don't look"),
+ * e só é refeita contra as rotas alteradas depois dela.
+ * 'capacityIndex' ordena as rotas pela capacidade residual, para o Relocate enumerar só as que
+ * comportam o serviço.
+ */
+struct SearchState {
+    vector<int> routeOf;
+    vector<int> posOf;
+    size_t version = 0;
+    vector<size_t> routeStamp;
+    vector<size_t> changeLog;
+    vector<size_t> relocateScan[2]; // Por serviço: vizinhança completa [0] e granular [1]
+    vector<size_t> swapScan;        // Por rota de origem, vizinhança completa
+    vector<size_t> swapScanGranular; // Por serviço
+    vector<size_t> twoOptScan;      // Por rota
+    CapacityIndex capacityIndex;
+};
+
+/**
+ * @struct Move
+ * @brief Um movimento avaliado da busca local, com a variação de custo de cada rota envolvida.
+ * Para Relocate, (r1, i1) é o serviço movido e (r2, i2) a posição de inserção; para Swap,
+ * são as posições dos dois serviços trocados.
+ */
+struct Move {
+    enum Type : char { NONE, RELOCATE, SWAP } type = NONE;
+    long long delta1 = 0, delta2 = 0;
+    size_t r1 = 0, i1 = 0, r2 = 0, i2 = 0;
+
+    long long delta() const { return delta1 + delta2; }
+
+    /**
+     * @brief Ordem total entre movimentos: menor variação de custo e, no empate, menores índices.
+     * Como não depende da ordem de avaliação, a escolha é a mesma com qualquer número de threads.
+     */
+    bool betterThan(const Move& other) const {
+        if (type == NONE) return false;
+        if (other.type == NONE) return true;
+        return make_tuple(delta(), r1, i1, r2, i2) < make_tuple(other.delta(), other.r1, other.i1, other.r2, other.i2);
+    }
+};
+
+/**
+ * @struct SearchRun
+ * @brief Estado de uma partida (trajetória) da busca local iterada: solução corrente, melhor
+ * solução da partida, gerador aleatório próprio e contadores. Permite retomar a busca em etapas.
+ */
+struct SearchRun {
+    Solution current, best;
+    mt19937 random;
+    long long iteration = 0;
+    long long stall = 0;
+    bool abandoned = false;
+};
+
+/**
+ * @struct Individual
+ * @brief Um indivíduo do algoritmo memético: a solução educada e, para a medida de diversidade,
+ * o vizinho anterior e o seguinte de cada serviço na sua rota (-1 para o depósito).
+ */
+struct Individual {
+    Solution solution;
+    vector<int> pred, succ;
+};
 
 /**
  * @class Solver
@@ -19,22 +223,106 @@ class Solver {
 private:
     Graph* graph;
     vector<Service> allServices;
+    shared_ptr<ServiceTable> serviceTable = make_shared<ServiceTable>();
     int depot;
     int capacity;
     string instanceName;
-    vector<vector<long long>> distances;
+    long long optimalValue = -1; // Valor ótimo conhecido da instância (-1 se desconhecido)
+    shared_ptr<const vector<vector<long long>>> distances; // Somente leitura; compartilhada com os subproblemas da decomposição
     bool areDistancesCalculated = false;
+    long long apspTimeMicroseconds = 0;
+    SolverConfig config;
+    mt19937 rng;
+    chrono::steady_clock::time_point deadline = chrono::steady_clock::time_point::max();
+    vector<uint32_t> neighbourList; // k vizinhos mais próximos de cada serviço, em blocos de 'neighbourCount'
+    size_t neighbourCount = 0;
+    unique_ptr<ThreadPool> searchPool; // Threads da avaliação paralela de vizinhanças (criadas sob demanda)
+    int vehicleBound = 0;              // Limite inferior do número de veículos
+    long long lowerBound = 0;          // Limite inferior do custo (ver computeLowerBounds)
+    atomic<bool> boundReached{false};  // Alguma busca encontrou uma solução com o custo do limite inferior
+    Solution warmStart;                // Solução de partida carregada (ver setWarmStart)
+    bool hasWarmStart = false;
 
     /**
      * @brief Garante que a matriz de distâncias seja calculada (via Floyd-Warshall) apenas uma vez e quando necessário.
      */
     void ensureDistancesCalculated() {
         if (!areDistancesCalculated) {
-            distances = graph->floydWarshall();
+            auto start = chrono::steady_clock::now();
+            distances = make_shared<const vector<vector<long long>>>(graph->floydWarshall());
             areDistancesCalculated = true;
+            apspTimeMicroseconds = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+        }
+    }
+
+    /**
+     * @brief Monta as listas dos k serviços mais próximos de cada serviço, pela menor distância
+     * entre o fim de um e o início do outro (em qualquer ordem e, para arestas, em qualquer sentido).
+     * Só refaz as listas se k mudar.
+     */
+    void ensureNeighbourLists() {
+        size_t n = serviceTable->size();
+        size_t k = config.neighbours > 0 ? min<size_t>(config.neighbours, n > 0 ? n - 1 : 0) : 0;
+        if (k == neighbourCount && neighbourList.size() == n * k) return;
+        ensureDistancesCalculated();
+        const ServiceTable& table = *serviceTable;
+        neighbourCount = k;
+        neighbourList.assign(n * k, 0);
+        if (k == 0) return;
+        // Menor distância do fim de 'a' ao início de 'b'; arestas podem ser percorridas nos dois sentidos
+        auto gap = [&](uint32_t a, uint32_t b) {
+            const vector<vector<long long>>& d = *distances;
+            long long best = d[table.v[a]][table.u[b]];
+            if (table.type[a] == 'E') best = min(best, d[table.u[a]][table.u[b]]);
+            if (table.type[b] == 'E') best = min(best, d[table.v[a]][table.v[b]]);
+            if (table.type[a] == 'E' && table.type[b] == 'E') best = min(best, d[table.u[a]][table.v[b]]);
+            return best;
+        };
+        vector<pair<long long, uint32_t>> candidates;
+        candidates.reserve(n);
+        for (uint32_t i = 0; i < n; ++i) {
+            candidates.clear();
+            for (uint32_t j = 0; j < n; ++j) {
+                if (i == j) continue;
+                candidates.emplace_back(min(gap(i, j), gap(j, i)), j);
+            }
+            nth_element(candidates.begin(), candidates.begin() + (k - 1), candidates.end());
+            sort(candidates.begin(), candidates.begin() + k);
+            for (size_t c = 0; c < k; ++c) neighbourList[i * k + c] = candidates[c].second;
         }
     }
 
+    /**
+     * @brief Imprime uma mensagem de progresso, se o modo verboso estiver ativo.
+     */
+    void log(const string& message) const {
+        if (config.verbose) cout << "LOG [" << instanceName << "]: " << message << endl;
+    }
+
+    /**
+     * @brief Indica se a busca deve parar: o limite de tempo da instância foi atingido ou já se encontrou
+     * uma solução com o custo do limite inferior, que não pode ser melhorada.
+     */
+    bool timeExpired() const {
+        return boundReached.load(memory_order_relaxed) || chrono::steady_clock::now() >= deadline;
+    }
+
+    /**
+     * @brief Sinaliza a parada das buscas se 'cost' atinge o limite inferior. O "Optimal value" das
+     * instâncias não entra aqui: em várias delas ele está abaixo do custo de qualquer solução válida.
+     */
+    void noteCost(long long cost) {
+        if (cost <= lowerBound) boundReached.store(true, memory_order_relaxed);
+    }
+
+    /**
+     * @brief Registra o instante em que 'best' foi encontrada (contado do início de solve()) e confere o limite.
+     */
+    void recordBest(Solution& best, chrono::steady_clock::time_point start) {
+        best.bestTimeMicroseconds = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+        noteCost(best.totalCost);
+    }
+
 public:
     /**
      * @brief Construtor da classe Solver.
@@ -44,7 +332,7 @@ public:
      * @param name O nome da instância, usado para logs.
      */
     Solver(Graph* g, int depotNode, int vehicleCapacity, string name) 
-        : graph(g), depot(depotNode), capacity(vehicleCapacity), instanceName(name) {
+        : graph(g), depot(depotNode), capacity(vehicleCapacity), instanceName(name), rng(config.seed) {
         if (!graph || depotNode < 0 || depotNode >= g->numNodes() || vehicleCapacity <= 0) {
             throw invalid_argument("Parâmetros do Solver inválidos.");
         }
@@ -55,6 +343,60 @@ public:
      */
     void addService(int id, char type, int u, int v, int demand, int serviceCost, int travelCost) {
         allServices.emplace_back(id, type, u, v, demand, serviceCost, travelCost);
+        serviceTable->add(allServices.back());
+    }
+
+    /**
+     * @brief Descreve a versão e a configuração do solver, usada para invalidar resultados em cache.
+     * Inclui as threads por instância: com limite de tempo, o resultado do multi-start, do memético e da
+     * decomposição depende delas.
+     */
+    static string configSignature(const SolverConfig& config) {
+        return "versao=" + SOLVER_VERSION + ";construtiva=" + constructionName(config.construction) +
+               ";semente=" + to_string(config.seed) + ";tempo=" + to_string(config.timeLimitSeconds) + ";iteracoes=" + to_string(config.maxIterations) +
+               ";vizinhos=" + to_string(config.neighbours) + ";melhor-melhoria=" + to_string(config.bestImprovement) +
+               ";threads-busca=" + to_string(config.searchThreads) + ";partidas=" + to_string(config.starts) + ";abandono=" + to_string(config.abandonGap) +
+               ";metaheuristica=" + metaheuristicName(config.metaheuristic) + ";populacao=" + to_string(config.population) +
+               ";grupos=" + to_string(config.clusters) + ";decomposicao=" + decompositionName(config.decomposition) +
+               ";partida-quente=" + to_string(config.warmStart);
+    }
+
+    /**
+     * @brief Define os parâmetros de execução (semente, limite de tempo).
+     */
+    void setConfig(const SolverConfig& newConfig) {
+        config = newConfig;
+        rng.seed(config.seed);
+    }
+
+    /**
+     * @brief Define o valor ótimo conhecido da instância (campo "Optimal value" do arquivo).
+     */
+    void setOptimalValue(long long value) { optimalValue = value; }
+
+    long long getOptimalValue() const { return optimalValue; }
+    int getDepot() const { return depot; }
+    int getCapacity() const { return capacity; }
+    long long getApspTimeMicroseconds() const { return apspTimeMicroseconds; }
+    int getVehicleBound() const { return vehicleBound; }
+    long long getLowerBound() const { return lowerBound; }
+    const string& getInstanceName() const { return instanceName; }
+    const vector<Service>& getServices() const { return allServices; }
+    const ServiceTable& getServiceTable() const { return *serviceTable; }
+
+    /**
+     * @brief Calcula antecipadamente a matriz de distâncias, permitindo que isso ocorra
+     * num estágio separado do pipeline de processamento em lote.
+     */
+    void precomputeDistances() { ensureDistancesCalculated(); }
+
+    /**
+     * @brief Usa uma matriz de distâncias já calculada (a da instância completa, num subproblema da
+     * decomposição), sem refazer o Floyd-Warshall. A matriz é compartilhada, não copiada.
+     */
+    void setDistances(shared_ptr<const vector<vector<long long>>> matrix) {
+        distances = move(matrix);
+        areDistancesCalculated = true;
     }
 
     /**
@@ -63,25 +405,47 @@ public:
      */
     long long getDistance(int from, int to) {
         ensureDistancesCalculated();
-        if (from < 0 || to < 0 || static_cast<size_t>(from) >= distances.size() || static_cast<size_t>(to) >= distances.size()) return INF;
-        return distances[from][to];
+        const vector<vector<long long>>& d = *distances;
+        if (from < 0 || to < 0 || static_cast<size_t>(from) >= d.size() || static_cast<size_t>(to) >= d.size()) return INF;
+        return d[from][to];
     }
     
+    /**
+     * @brief Acesso direto à matriz de distâncias, sem verificação de limites, para a avaliação de movimentos.
+     * Após uma construção viável, todas as distâncias entre depósito e extremos de serviços são finitas
+     * (qualquer par se liga passando pelo depósito), então as variações de custo não estouram.
+     */
+    long long dist(int from, int to) const { return (*distances)[from][to]; }
+
+    /**
+     * @brief Nó onde o veículo está antes da posição 'pos' da rota (o depósito, no início).
+     */
+    int endNodeBefore(const vector<uint32_t>& services, size_t pos) const {
+        return pos == 0 ? depot : serviceTable->endOf(services[pos - 1]);
+    }
+
+    /**
+     * @brief Nó para onde o veículo segue a partir da posição 'pos' da rota (o depósito, após o fim).
+     */
+    int startNodeAt(const vector<uint32_t>& services, size_t pos) const {
+        return pos >= services.size() ? depot : serviceTable->startOf(services[pos]);
+    }
+
     /**
      * @brief Calcula o custo total exato de uma rota, somando custos de deslocamento e de serviço.
-     * @param services Vetor de serviços que compõem a rota.
+     * @param services Índices (na ServiceTable) dos serviços que compõem a rota.
      * @return O custo total da rota, ou INF se a rota for inviável.
      */
-    long long calculateRouteCost(const vector<Service>& services) {
+    long long calculateRouteCost(const vector<uint32_t>& services) {
         if (services.empty()) return 0;
+        const ServiceTable& table = *serviceTable;
         long long currentCost = 0;
         int lastNode = depot;
-        for (const auto& service : services) {
-            long long travelToServiceCost = getDistance(lastNode, service.u);
+        for (uint32_t s : services) {
+            long long travelToServiceCost = getDistance(lastNode, table.startOf(s));
             if (travelToServiceCost >= INF) return INF;
-            currentCost += travelToServiceCost + service.serviceCost;
-            if (service.type != 'N') currentCost += service.travelCost;
-            lastNode = service.v;
+            currentCost += travelToServiceCost + table.cost[serviceOf(s)];
+            lastNode = table.endOf(s);
         }
         long long travelToDepotCost = getDistance(lastNode, depot);
         if (travelToDepotCost >= INF) return INF;
@@ -98,8 +462,8 @@ public:
         solution.totalCost = 0;
         for (auto& route : solution.routes) {
             route.totalDemand = 0;
-            for (const auto& service : route.services) {
-                route.totalDemand += service.demand;
+            for (uint32_t s : route.services) {
+                route.totalDemand += serviceTable->demand[serviceOf(s)];
             }
             route.totalCost = calculateRouteCost(route.services);
             if (route.totalCost >= INF) {
@@ -112,6 +476,52 @@ public:
             [](const Route& r){ return r.services.empty(); }), solution.routes.end());
     }
 
+    /**
+     * @brief Atualiza incrementalmente as métricas de uma rota alterada por um movimento aceito,
+     * mantendo o custo total da solução como uma soma corrente.
+     * @param solution A solução.
+     * @param r_idx O índice da rota alterada.
+     * @param costDelta A variação do custo da rota.
+     * @param demandDelta A variação da demanda da rota.
+     */
+    void updateRoute(Solution& solution, size_t r_idx, long long costDelta, int demandDelta) {
+        solution.routes[r_idx].totalCost += costDelta;
+        solution.routes[r_idx].totalDemand += demandDelta;
+        solution.totalCost += costDelta;
+    }
+
+    /**
+     * @brief Remove uma rota que ficou vazia em O(1), trocando-a com a última rota.
+     * A ordem das rotas não é significativa: os ids são renumerados ao final de solve().
+     * @return True se a rota foi removida.
+     */
+    bool removeRouteIfEmpty(Solution& solution, size_t r_idx) {
+        if (!solution.routes[r_idx].services.empty()) return false;
+        if (r_idx + 1 != solution.routes.size()) {
+            swap(solution.routes[r_idx], solution.routes.back());
+        }
+        solution.routes.pop_back();
+        return true;
+    }
+
+    /**
+     * @brief Confere se todos os serviços podem ser atendidos: demanda dentro da capacidade e
+     * serviço alcançável a partir do depósito (ida e volta).
+     */
+    bool servicesAreServiceable() {
+        for (uint32_t s = 0; s < serviceTable->size(); ++s) {
+            if (serviceTable->demand[s] > capacity) {
+                if (config.verbose) cerr << "ERRO CRÍTICO [" << instanceName << "]: Serviço " << serviceTable->id[s] << " tem demanda maior que a capacidade." << endl;
+                return false;
+            }
+            if (calculateRouteCost(vector<uint32_t>{s}) >= INF) {
+                if (config.verbose) cerr << "ERRO CRÍTICO [" << instanceName << "]: Serviço " << serviceTable->id[s] << " é inalcançável." << endl;
+                return false;
+            }
+        }
+        return true;
+    }
+
     /**
      * @brief (Etapa 2) Constrói uma solução inicial viável, mas ingênua.
      * Cria uma rota separada para cada serviço obrigatório (Depósito -> Serviço -> Depósito).
@@ -119,21 +529,16 @@ public:
      */
     Solution constructInitialSolution() {
         Solution solution;
+        solution.serviceTable = serviceTable;
+        if (!servicesAreServiceable()) {
+            solution.totalCost = INF;
+            return solution;
+        }
         int routeIdCounter = 1;
-        for (const auto& service : allServices) {
-            if (service.demand > capacity) {
-                cerr << "ERRO CRÍTICO [" << instanceName << "]: Serviço " << service.id << " tem demanda maior que a capacidade." << endl;
-                solution.totalCost = INF;
-                return solution;
-            }
+        for (uint32_t s = 0; s < serviceTable->size(); ++s) {
             Route newRoute;
             newRoute.id = routeIdCounter++;
-            newRoute.services.push_back(service);
-            if (calculateRouteCost(newRoute.services) >= INF) {
-                cerr << "ERRO CRÍTICO [" << instanceName << "]: Serviço " << service.id << " é inalcançável." << endl;
-                solution.totalCost = INF;
-                return solution;
-            }
+            newRoute.services.push_back(s);
             solution.routes.push_back(newRoute);
         }
         recalculateSolutionMetrics(solution);
@@ -141,182 +546,2070 @@ public:
     }
 
     /**
-     * @brief Tenta mover um serviço de uma rota para outra (inter-rota).
-     * @return True se uma melhoria foi encontrada e aplicada, false caso contrário.
+     * @brief Path-scanning: cada rota sai do depósito e é estendida com o serviço não atendido mais
+     * próximo do fim da rota que ainda cabe no veículo (arestas entram no sentido mais próximo).
+     * Empates de distância são desfeitos por uma das cinco regras clássicas:
+     * 1) maximizar a distância do fim do serviço ao depósito; 2) minimizá-la;
+     * 3) maximizar demanda / custo do serviço; 4) minimizá-la;
+     * 5) regra 1 se o veículo está abaixo da metade da capacidade, senão regra 2.
+     * @param rule A regra de desempate (1 a 5), ou 0 para sortear uma regra por rota e desempatar
+     * aleatoriamente os candidatos que a regra não distingue.
      */
-    bool tryRelocate(Solution& solution) {
-        for (size_t r1_idx = 0; r1_idx < solution.routes.size(); ++r1_idx) {
-            for (size_t s_idx = 0; s_idx < solution.routes[r1_idx].services.size(); ++s_idx) {
-                Service service_to_move = solution.routes[r1_idx].services[s_idx];
-                for (size_t r2_idx = 0; r2_idx < solution.routes.size(); ++r2_idx) {
-                    if (r1_idx == r2_idx) continue;
-                    if (solution.routes[r2_idx].totalDemand + service_to_move.demand > capacity) continue;
-                    vector<Service> r1_after_removal = solution.routes[r1_idx].services;
-                    r1_after_removal.erase(r1_after_removal.begin() + s_idx);
-                    long long cost_r1_after = calculateRouteCost(r1_after_removal);
-                    
-                    for (size_t pos = 0; pos <= solution.routes[r2_idx].services.size(); ++pos) {
-                        vector<Service> r2_after_insertion = solution.routes[r2_idx].services;
-                        r2_after_insertion.insert(r2_after_insertion.begin() + pos, service_to_move);
-                        long long cost_r2_after = calculateRouteCost(r2_after_insertion);
-                        if (cost_r1_after != INF && cost_r2_after != INF && cost_r1_after + cost_r2_after < solution.routes[r1_idx].totalCost + solution.routes[r2_idx].totalCost) {
-                            solution.routes[r1_idx].services = r1_after_removal;
-                            solution.routes[r2_idx].services = r2_after_insertion;
-                            recalculateSolutionMetrics(solution);
-                            return true;
-                        }
+    Solution pathScanning(int rule, mt19937& random) {
+        const ServiceTable& table = *serviceTable;
+        Solution solution;
+        solution.serviceTable = serviceTable;
+        vector<char> served(table.size(), 0);
+        size_t remaining = table.size();
+        // Compara dois candidatos à mesma distância: < 0 se 'a' é preferido, > 0 se 'b' é preferido
+        auto compare = [&](int routeRule, uint32_t a, uint32_t b, int load) -> long long {
+            if (routeRule == 5) routeRule = 2 * load < capacity ? 1 : 2;
+            switch (routeRule) {
+                case 1: return dist(table.endOf(b), depot) - dist(table.endOf(a), depot);
+                case 2: return dist(table.endOf(a), depot) - dist(table.endOf(b), depot);
+                case 3: return table.demand[serviceOf(b)] * table.cost[serviceOf(a)] - table.demand[serviceOf(a)] * table.cost[serviceOf(b)];
+                case 4: return table.demand[serviceOf(a)] * table.cost[serviceOf(b)] - table.demand[serviceOf(b)] * table.cost[serviceOf(a)];
+            }
+            return 0;
+        };
+        while (remaining > 0) {
+            Route route;
+            route.id = solution.routes.size() + 1;
+            int routeRule = rule > 0 ? rule : uniform_int_distribution<int>(1, 5)(random);
+            int load = 0, current = depot;
+            while (true) {
+                long long bestDistance = INF;
+                uint32_t chosen = 0;
+                size_t ties = 0;
+                for (uint32_t s = 0; s < table.size(); ++s) {
+                    if (served[s] || load + table.demand[s] > capacity) continue;
+                    uint32_t visit = s;
+                    if (table.type[s] == 'E' && dist(current, table.v[s]) < dist(current, table.u[s])) visit = table.reversed(s);
+                    long long d = dist(current, table.startOf(visit));
+                    if (d >= INF || d > bestDistance) continue;
+                    long long preference = d < bestDistance ? -1 : compare(routeRule, visit, chosen, load);
+                    if (preference < 0) {
+                        bestDistance = d;
+                        chosen = visit;
+                        ties = 1;
+                    } else if (preference == 0 && rule == 0 && uniform_int_distribution<size_t>(0, ties++)(random) == 0) {
+                        chosen = visit;
                     }
                 }
+                if (bestDistance >= INF) break;
+                route.services.push_back(chosen);
+                load += table.demand[serviceOf(chosen)];
+                current = table.endOf(chosen);
+                served[serviceOf(chosen)] = 1;
+                remaining--;
+            }
+            if (route.services.empty()) {
+                solution.totalCost = INF;
+                return solution;
             }
+            solution.routes.push_back(route);
         }
-        return false;
+        recalculateSolutionMetrics(solution);
+        return solution;
     }
 
     /**
-     * @brief Tenta trocar (swap) um serviço de uma rota com um serviço de outra.
-     * @return True se uma melhoria foi encontrada e aplicada, false caso contrário.
+     * @brief Economias de Clarke-Wright adaptadas a serviços em nós, arestas e arcos. Parte de uma rota
+     * por serviço e junta repetidamente o par de rotas de maior economia
+     * d(fim de A, depósito) + d(depósito, início de B) - d(fim de A, início de B) que cabe no veículo.
+     * Cada par é avaliado nas duas ordens e com cada rota invertida, se ela não tiver arcos.
+     * As economias ficam num heap com invalidação preguiçosa: cada entrada guarda a versão das duas rotas
+     * e é descartada ao sair do heap se alguma delas mudou; a rota resultante de uma junção reinsere
+     * suas economias com as demais, num total de O(n²) entradas e O(n² log n) operações.
      */
-    bool trySwap(Solution& solution) {
-        for (size_t r1_idx = 0; r1_idx < solution.routes.size(); ++r1_idx) {
-            for (size_t r2_idx = r1_idx + 1; r2_idx < solution.routes.size(); ++r2_idx) {
-                for (size_t s1_idx = 0; s1_idx < solution.routes[r1_idx].services.size(); ++s1_idx) {
-                    for (size_t s2_idx = 0; s2_idx < solution.routes[r2_idx].services.size(); ++s2_idx) {
-                        Service s1 = solution.routes[r1_idx].services[s1_idx];
-                        Service s2 = solution.routes[r2_idx].services[s2_idx];
-                        if (solution.routes[r1_idx].totalDemand - s1.demand + s2.demand <= capacity &&
-                            solution.routes[r2_idx].totalDemand - s2.demand + s1.demand <= capacity) {
-                            vector<Service> new_r1_services = solution.routes[r1_idx].services;
-                            vector<Service> new_r2_services = solution.routes[r2_idx].services;
-                            new_r1_services[s1_idx] = s2;
-                            new_r2_services[s2_idx] = s1;
-                            long long cost_new_r1 = calculateRouteCost(new_r1_services);
-                            long long cost_new_r2 = calculateRouteCost(new_r2_services);
-                            if (cost_new_r1 != INF && cost_new_r2 != INF && cost_new_r1 + cost_new_r2 < solution.routes[r1_idx].totalCost + solution.routes[r2_idx].totalCost) {
-                                solution.routes[r1_idx].services = new_r1_services;
-                                solution.routes[r2_idx].services = new_r2_services;
-                                recalculateSolutionMetrics(solution);
-                                return true;
-                            }
-                        }
-                    }
+    Solution savings() {
+        const ServiceTable& table = *serviceTable;
+        Solution solution;
+        solution.serviceTable = serviceTable;
+        if (!servicesAreServiceable()) {
+            solution.totalCost = INF;
+            return solution;
+        }
+        const uint32_t n = table.size();
+        vector<vector<uint32_t>> routes(n);
+        vector<int> load(n);
+        vector<uint32_t> version(n, 0);
+        vector<char> reversible(n), alive(n, 1);
+        for (uint32_t s = 0; s < n; ++s) {
+            routes[s] = {s};
+            load[s] = table.demand[s];
+            reversible[s] = table.type[s] != 'A';
+        }
+        auto routeStart = [&](uint32_t r, bool rev) { return rev ? table.endOf(routes[r].back()) : table.startOf(routes[r].front()); };
+        auto routeEnd = [&](uint32_t r, bool rev) { return rev ? table.startOf(routes[r].front()) : table.endOf(routes[r].back()); };
+
+        // Junção candidata: a rota 'first' (invertida se revFirst) seguida da rota 'second' (invertida se revSecond)
+        struct Merge {
+            long long saving;
+            uint32_t first, second, versionFirst, versionSecond;
+            bool revFirst, revSecond;
+            bool operator<(const Merge& o) const { // Maior economia primeiro; empates pelos menores índices
+                return tie(saving, o.first, o.second, o.revFirst, o.revSecond) < tie(o.saving, first, second, revFirst, revSecond);
+            }
+        };
+        priority_queue<Merge> heap;
+        // Insere a melhor junção (positiva) entre as rotas x e y, se a demanda somada couber no veículo
+        auto pushBest = [&](uint32_t x, uint32_t y) {
+            if (load[x] + load[y] > capacity) return;
+            Merge best{0, 0, 0, 0, 0, false, false};
+            for (int order = 0; order < 2; ++order) {
+                uint32_t a = order ? y : x, b = order ? x : y;
+                for (int mask = 0; mask < 4; ++mask) {
+                    bool revA = mask & 1, revB = mask & 2;
+                    if ((revA && !reversible[a]) || (revB && !reversible[b])) continue;
+                    int end = routeEnd(a, revA), start = routeStart(b, revB);
+                    long long toDepot = dist(end, depot), fromDepot = dist(depot, start), link = dist(end, start);
+                    if (toDepot >= INF || fromDepot >= INF || link >= INF) continue;
+                    Merge candidate{toDepot + fromDepot - link, a, b, version[a], version[b], revA, revB};
+                    if (candidate.saving > 0 && best < candidate) best = candidate;
                 }
             }
+            if (best.saving > 0) heap.push(best);
+        };
+        for (uint32_t x = 0; x < n; ++x) {
+            for (uint32_t y = x + 1; y < n; ++y) pushBest(x, y);
         }
-        return false;
+
+        while (!heap.empty()) {
+            Merge m = heap.top();
+            heap.pop();
+            if (!alive[m.first] || !alive[m.second] || version[m.first] != m.versionFirst || version[m.second] != m.versionSecond) continue;
+            auto orient = [&](uint32_t r, bool rev) {
+                if (!rev) return;
+                reverse(routes[r].begin(), routes[r].end());
+                for (auto& visit : routes[r]) visit = table.reversed(visit);
+            };
+            orient(m.first, m.revFirst);
+            orient(m.second, m.revSecond);
+            routes[m.first].insert(routes[m.first].end(), routes[m.second].begin(), routes[m.second].end());
+            load[m.first] += load[m.second];
+            reversible[m.first] = reversible[m.first] && reversible[m.second];
+            version[m.first]++;
+            alive[m.second] = 0;
+            vector<uint32_t>().swap(routes[m.second]);
+            for (uint32_t other = 0; other < n; ++other) {
+                if (alive[other] && other != m.first) pushBest(m.first, other);
+            }
+        }
+
+        for (uint32_t r = 0; r < n; ++r) {
+            if (!alive[r]) continue;
+            Route route;
+            route.id = solution.routes.size() + 1;
+            route.services = move(routes[r]);
+            solution.routes.push_back(route);
+        }
+        recalculateSolutionMetrics(solution);
+        return solution;
     }
-    
+
     /**
-     * @brief Aplica a heurística 2-opt para otimizar o caminho DENTRO de cada rota.
-     * Tenta remover cruzamentos no percurso.
-     * @return True se uma melhoria foi encontrada e aplicada, false caso contrário.
+     * @brief Concatena as rotas de uma solução num tour gigante (a ordem de todas as visitas, sem o depósito).
      */
-    bool try2Opt(Solution& solution) {
-        for(size_t r_idx = 0; r_idx < solution.routes.size(); ++r_idx) {
-            if (solution.routes[r_idx].services.size() < 2) continue;
-            bool local_improvement = true;
-            while(local_improvement) {
-                local_improvement = false;
-                for (size_t i = 0; i < solution.routes[r_idx].services.size() - 1; ++i) {
-                    for (size_t j = i + 1; j < solution.routes[r_idx].services.size(); ++j) {
-                        vector<Service> new_services = solution.routes[r_idx].services;
-                        reverse(new_services.begin() + i, new_services.begin() + j + 1);
-                        long long new_cost = calculateRouteCost(new_services);
-                        if (new_cost < solution.routes[r_idx].totalCost) {
-                            solution.routes[r_idx].services = new_services;
-                            recalculateSolutionMetrics(solution);
-                            local_improvement = true;
-                            return true;
-                        }
-                    }
+    static vector<uint32_t> giantTour(const Solution& solution) {
+        vector<uint32_t> tour;
+        for (const auto& route : solution.routes) tour.insert(tour.end(), route.services.begin(), route.services.end());
+        return tour;
+    }
+
+    /**
+     * @brief Split de Prins pelo caminho mínimo no grafo auxiliar acíclico: o arco (i, j) representa
+     * a rota que atende tour[i..j-1] e só existe se a demanda cabe no veículo. Os arcos de cada i são
+     * gerados estendendo a rota, em O(n * b), com b o maior número de serviços numa rota.
+     * @param tour O tour gigante (visitas com o sentido de cada aresta já definido).
+     * @param totalCost Recebe o custo da melhor partição (INF se não houver).
+     * @return O predecessor de cada posição no caminho mínimo: a rota que termina em j começa em pred[j].
+     */
+    vector<size_t> splitBellman(const vector<uint32_t>& tour, long long& totalCost) const {
+        const ServiceTable& table = *serviceTable;
+        const size_t n = tour.size();
+        vector<long long> best(n + 1, INF);
+        vector<size_t> pred(n + 1, 0);
+        best[0] = 0;
+        for (size_t i = 0; i < n; ++i) {
+            if (best[i] >= INF) continue;
+            int load = 0;
+            long long cost = 0;
+            for (size_t j = i; j < n; ++j) {
+                load += table.demand[serviceOf(tour[j])];
+                if (load > capacity) break;
+                cost += dist(j == i ? depot : table.endOf(tour[j - 1]), table.startOf(tour[j])) + table.cost[serviceOf(tour[j])];
+                long long routeCost = cost + dist(table.endOf(tour[j]), depot);
+                if (best[i] + routeCost < best[j + 1]) {
+                    best[j + 1] = best[i] + routeCost;
+                    pred[j + 1] = i;
                 }
             }
         }
-        return false;
+        totalCost = best[n];
+        return pred;
     }
 
     /**
-     * @brief (Etapa 3) Executa uma busca local baseada em vizinhanças variáveis (VNS).
-     * Aplica repetidamente os movimentos Relocate, Swap e 2-opt até que nenhuma melhoria seja possível.
-     * @param solution A solução a ser otimizada.
+     * @brief Split em tempo linear para a restrição de capacidade (Vidal, 2016).
+     * Com P[j] o custo de percorrer tour[0..j-1] sem voltar ao depósito, a rota (i, j) custa
+     * d(depósito, início de tour[i]) + P[j] - P[i] - d(fim de tour[i-1], início de tour[i]) + d(fim de tour[j-1], depósito),
+     * de modo que V[j] = min f(i) + P[j] + d(fim de tour[j-1], depósito) sobre uma janela de i que só anda
+     * para a direita (a da capacidade). O mínimo da janela é mantido numa deque monótona.
+     * @param tour O tour gigante (visitas com o sentido de cada aresta já definido).
+     * @param totalCost Recebe o custo da melhor partição (INF se não houver).
+     * @return O predecessor de cada posição, como em splitBellman.
      */
-    void localSearch(Solution& solution) {
-        bool improvement = true;
-        while(improvement){
-            improvement = false;
-            if (tryRelocate(solution)) {
-                improvement = true;
-                continue;
-            }
-            if (trySwap(solution)) {
-                improvement = true;
-                continue;
+    vector<size_t> splitLinear(const vector<uint32_t>& tour, long long& totalCost) const {
+        const ServiceTable& table = *serviceTable;
+        const size_t n = tour.size();
+        vector<long long> prefixCost(n + 1, 0), prefixLoad(n + 1, 0), f(n + 1, 0), best(n + 1, INF);
+        vector<size_t> pred(n + 1, 0);
+        // Deslocamento do fim de tour[i-1] ao início de tour[i] (0 para i = 0)
+        auto link = [&](size_t i) { return i == 0 ? 0 : dist(table.endOf(tour[i - 1]), table.startOf(tour[i])); };
+        for (size_t j = 1; j <= n; ++j) {
+            prefixCost[j] = prefixCost[j - 1] + link(j - 1) + table.cost[serviceOf(tour[j - 1])];
+            prefixLoad[j] = prefixLoad[j - 1] + table.demand[serviceOf(tour[j - 1])];
+        }
+        best[0] = 0;
+        deque<size_t> window;
+        if (n > 0) {
+            f[0] = dist(depot, table.startOf(tour[0]));
+            window.push_back(0);
+        }
+        for (size_t j = 1; j <= n; ++j) {
+            while (!window.empty() && prefixLoad[j] - prefixLoad[window.front()] > capacity) window.pop_front();
+            if (window.empty()) {
+                totalCost = INF;
+                return pred;
             }
-            if (try2Opt(solution)) {
-                improvement = true;
-                continue;
+            size_t i = window.front();
+            best[j] = f[i] + prefixCost[j] + dist(table.endOf(tour[j - 1]), depot);
+            pred[j] = i;
+            if (j < n) {
+                f[j] = best[j] + dist(depot, table.startOf(tour[j])) - prefixCost[j] - link(j);
+                while (!window.empty() && f[window.back()] >= f[j]) window.pop_back();
+                window.push_back(j);
             }
         }
+        totalCost = best[n];
+        return pred;
     }
 
     /**
-     * @brief Orquestra todo o processo: construção da solução inicial e otimização.
-     * @return A solução final (otimizada).
+     * @brief Divide um tour gigante de forma ótima em rotas que respeitam a capacidade (Split linear).
+     * @return A solução correspondente, ou uma solução com custo INF se algum serviço não couber no veículo.
      */
-    Solution solve() {
-        auto start = chrono::high_resolution_clock::now();
-        cout << "LOG [" << instanceName << "]: Total de serviços a serem atendidos: " << allServices.size() << endl;
-        ensureDistancesCalculated();
-        Solution solution = constructInitialSolution();
-        if (solution.totalCost < INF) {
-            cout << "LOG [" << instanceName << "]: Iniciando busca local..." << endl;
-            localSearch(solution);
-            cout << "LOG [" << instanceName << "]: Busca local concluida. Custo final: " << solution.totalCost << endl;
-        } else {
-             cout << "ERRO [" << instanceName << "]: Não foi possível construir uma solução inicial viável. Otimizacao abortada." << endl;
+    Solution split(const vector<uint32_t>& tour) {
+        Solution solution;
+        solution.serviceTable = serviceTable;
+        long long totalCost;
+        vector<size_t> pred = splitLinear(tour, totalCost);
+        if (totalCost >= INF) {
+            solution.totalCost = INF;
+            return solution;
         }
-        auto end = chrono::high_resolution_clock::now();
-        solution.executionTimeMicroseconds = chrono::duration_cast<chrono::microseconds>(end - start).count();
-        for(size_t i = 0; i < solution.routes.size(); ++i) {
-            solution.routes[i].id = i + 1;
+        for (size_t j = tour.size(); j > 0; j = pred[j]) {
+            Route route;
+            route.services.assign(tour.begin() + pred[j], tour.begin() + j);
+            solution.routes.push_back(route);
         }
+        reverse(solution.routes.begin(), solution.routes.end());
+        for (size_t r = 0; r < solution.routes.size(); ++r) solution.routes[r].id = r + 1;
+        recalculateSolutionMetrics(solution);
         return solution;
     }
 
     /**
-     * @brief Salva a solução final em um arquivo, seguindo o formato especificado.
-     * @param solution A solução a ser salva.
-     * @param instanceName O nome do arquivo de saída.
+     * @brief Constrói a solução de partida com a heurística construtiva configurada.
+     * Nas economias, as junções são feitas na ordem das maiores economias.
+     * No path-scanning determinístico, as cinco regras são executadas e fica a de menor custo. As rotas
+     * do path-scanning são ainda reparticionadas pelo Split, o que nunca piora o custo: a partição
+     * original é uma das que o Split considera.
      */
-    void saveSolution(const Solution& solution, const string& instanceName) {
-        string dirPath = "solucoes";
-        try { if (!filesystem::exists(dirPath)) filesystem::create_directories(dirPath); }
-        catch (const exception& e) { cerr << "Erro ao criar diretório " << dirPath << ": " << e.what() << endl; return; }
-        string solutionPath = dirPath + "/sol-" + instanceName;
-        ofstream out(solutionPath);
-        if (!out.is_open()) { cerr << "Erro ao criar arquivo de solucao em: " << solutionPath << endl; return; }
-        if (solution.totalCost >= INF || (solution.routes.empty() && !allServices.empty()) ) {
-            out << "inviavel" << endl;
-        } else {
-            out << solution.totalCost << endl;
-            out << solution.routes.size() << endl;
-            out << solution.executionTimeMicroseconds << endl;
-            out << solution.executionTimeMicroseconds << endl;
-            for (const auto& route : solution.routes) {
-                out << " 0 1 " << route.id << " " << route.totalDemand << " " << route.totalCost 
-                    << " " << (route.services.size() + 2);
-                out << " (D 0," << depot + 1 << "," << depot + 1 << ")";
-                for (const auto& service : route.services) {
-                    out << " (S " << service.id << "," << service.u + 1 << "," << service.v + 1 << ")";
-                }
-                out << " (D 0," << depot + 1 << "," << depot + 1 << ")";
-                out << endl;
-            }
+    Solution constructSolution(mt19937& random) {
+        if (config.construction == Construction::SingleServiceRoutes) return constructInitialSolution();
+        if (config.construction == Construction::Savings) return savings();
+        Solution best;
+        best.serviceTable = serviceTable;
+        best.totalCost = INF;
+        if (!servicesAreServiceable()) return best;
+        if (config.construction == Construction::PathScanningRandom) return split(giantTour(pathScanning(0, random)));
+        for (int rule = 1; rule <= 5; ++rule) {
+            Solution candidate = split(giantTour(pathScanning(rule, random)));
+            if (candidate.totalCost < best.totalCost) best = move(candidate);
         }
-        out.close();
-        if(solution.totalCost < INF) {
-            cout << "Solucao salva em: " << solutionPath << endl;
-            cout << "  - Custo Total: " << solution.totalCost << endl;
-            cout << "  - N. de Rotas: " << solution.routes.size() << endl;
+        return best;
+    }
+
+    /**
+     * @brief Marca a rota como alterada na versão atual da busca e atualiza sua capacidade residual.
+     */
+    void touchRoute(const Solution& solution, SearchState& state, size_t r_idx) const {
+        state.routeStamp[r_idx] = ++state.version;
+        state.changeLog.push_back(r_idx);
+        state.capacityIndex.update(r_idx, capacity - solution.routes[r_idx].totalDemand);
+    }
+
+    /**
+     * @brief Lista, em ordem crescente, as rotas existentes alteradas depois da versão 'since'.
+     * Percorre só o registro de alterações recentes, a menos que ele seja maior que o número de rotas.
+     */
+    void routesChangedSince(const SearchState& state, size_t since, size_t numRoutes, vector<size_t>& out) const {
+        out.clear();
+        if (state.version - since >= numRoutes) {
+            for (size_t r = 0; r < numRoutes; ++r) if (state.routeStamp[r] > since) out.push_back(r);
+            return;
+        }
+        for (size_t v = since; v < state.version; ++v) {
+            size_t r = state.changeLog[v];
+            if (r < numRoutes && state.routeStamp[r] == v + 1) out.push_back(r);
+        }
+        sort(out.begin(), out.end());
+    }
+
+    /**
+     * @brief Registra a rota e a posição de cada serviço de uma rota no índice da busca e marca a rota como alterada.
+     */
+    void indexRoute(const Solution& solution, SearchState& state, size_t r_idx) const {
+        touchRoute(solution, state, r_idx);
+        const vector<uint32_t>& services = solution.routes[r_idx].services;
+        for (size_t p = 0; p < services.size(); ++p) {
+            state.routeOf[serviceOf(services[p])] = r_idx;
+            state.posOf[serviceOf(services[p])] = p;
+        }
+    }
+
+    /**
+     * @brief Constrói o índice de posições da busca local para uma solução.
+     */
+    SearchState buildSearchState(const Solution& solution) const {
+        SearchState state;
+        state.routeOf.assign(serviceTable->size(), -1);
+        state.posOf.assign(serviceTable->size(), -1);
+        state.routeStamp.assign(solution.routes.size(), 0);
+        state.relocateScan[0].assign(serviceTable->size(), 0);
+        state.relocateScan[1].assign(serviceTable->size(), 0);
+        state.swapScan.assign(solution.routes.size(), 0);
+        state.swapScanGranular.assign(serviceTable->size(), 0);
+        state.twoOptScan.assign(solution.routes.size(), 0);
+        state.capacityIndex.build(vector<int>(solution.routes.size(), INT_MIN));
+        for (size_t r = 0; r < solution.routes.size(); ++r) indexRoute(solution, state, r);
+        return state;
+    }
+
+    /**
+     * @brief Variação do custo de deslocamento ao remover o serviço da posição 'pos' (sem o custo do serviço).
+     */
+    long long removalDelta(const vector<uint32_t>& route, size_t pos) const {
+        uint32_t s = route[pos];
+        int prev = endNodeBefore(route, pos), next = startNodeAt(route, pos + 1);
+        return dist(prev, next) - dist(prev, serviceTable->startOf(s)) - dist(serviceTable->endOf(s), next);
+    }
+
+    /**
+     * @brief Variação do custo de deslocamento ao inserir 's' antes da posição 'pos' (sem o custo do serviço).
+     */
+    long long insertionDelta(const vector<uint32_t>& route, size_t pos, uint32_t s) const {
+        int before = endNodeBefore(route, pos), after = startNodeAt(route, pos);
+        return dist(before, serviceTable->startOf(s)) + dist(serviceTable->endOf(s), after) - dist(before, after);
+    }
+
+    /**
+     * @brief Variação do custo da rota ao substituir o serviço da posição 'pos' por 's'.
+     */
+    long long replacementDelta(const vector<uint32_t>& route, size_t pos, uint32_t s) const {
+        const ServiceTable& table = *serviceTable;
+        uint32_t old = route[pos];
+        int prev = endNodeBefore(route, pos), next = startNodeAt(route, pos + 1);
+        return dist(prev, table.startOf(s)) + table.cost[serviceOf(s)] + dist(table.endOf(s), next)
+             - dist(prev, table.startOf(old)) - table.cost[serviceOf(old)] - dist(table.endOf(old), next);
+    }
+
+    /**
+     * @brief Aplica um relocate já avaliado: move o serviço da posição 's_idx' da rota 'r1_idx' para
+     * antes da posição 'pos' da rota 'r2_idx', atualizando métricas e o índice de posições.
+     */
+    void applyRelocate(Solution& solution, SearchState& state, size_t r1_idx, size_t s_idx, size_t r2_idx, size_t pos,
+                       long long removal_delta, long long insertion_delta) {
+        uint32_t s = solution.routes[r1_idx].services[s_idx];
+        solution.routes[r1_idx].services.erase(solution.routes[r1_idx].services.begin() + s_idx);
+        solution.routes[r2_idx].services.insert(solution.routes[r2_idx].services.begin() + pos, s);
+        updateRoute(solution, r1_idx, removal_delta - serviceTable->cost[serviceOf(s)], -serviceTable->demand[serviceOf(s)]);
+        updateRoute(solution, r2_idx, insertion_delta + serviceTable->cost[serviceOf(s)], serviceTable->demand[serviceOf(s)]);
+        indexRoute(solution, state, r1_idx);
+        indexRoute(solution, state, r2_idx);
+        size_t last = solution.routes.size() - 1;
+        if (removeRouteIfEmpty(solution, r1_idx)) state.capacityIndex.update(last, INT_MIN);
+        if (r1_idx < solution.routes.size()) indexRoute(solution, state, r1_idx);
+    }
+
+    /**
+     * @brief Aplica um swap já avaliado entre r1[s1_idx] e r2[s2_idx].
+     */
+    void applySwap(Solution& solution, SearchState& state, size_t r1_idx, size_t s1_idx, size_t r2_idx, size_t s2_idx,
+                   long long delta1, long long delta2) {
+        vector<uint32_t>& r1 = solution.routes[r1_idx].services;
+        vector<uint32_t>& r2 = solution.routes[r2_idx].services;
+        int demandDelta = serviceTable->demand[serviceOf(r2[s2_idx])] - serviceTable->demand[serviceOf(r1[s1_idx])];
+        swap(r1[s1_idx], r2[s2_idx]);
+        updateRoute(solution, r1_idx, delta1, demandDelta);
+        updateRoute(solution, r2_idx, delta2, -demandDelta);
+        state.routeOf[serviceOf(r1[s1_idx])] = r1_idx;
+        state.posOf[serviceOf(r1[s1_idx])] = s1_idx;
+        state.routeOf[serviceOf(r2[s2_idx])] = r2_idx;
+        state.posOf[serviceOf(r2[s2_idx])] = s2_idx;
+        touchRoute(solution, state, r1_idx);
+        touchRoute(solution, state, r2_idx);
+    }
+
+    /**
+     * @brief Indica se a rota do serviço ou a de algum dos seus vizinhos mudou depois da versão 'since'.
+     */
+    bool neighbourhoodChangedSince(const SearchState& state, uint32_t s, size_t since) const {
+        if (state.routeStamp[state.routeOf[s]] > since) return true;
+        const uint32_t* near = &neighbourList[s * neighbourCount];
+        for (size_t c = 0; c < neighbourCount; ++c) {
+            if (state.routeStamp[state.routeOf[near[c]]] > since) return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Tenta mover um serviço de uma rota para outra (inter-rota).
+     * Cada candidato é avaliado em O(1) pela variação de custo nos vizinhos do serviço removido e
+     * da posição de inserção; as rotas só são alteradas quando o movimento é aceito.
+     * Com vizinhança granular, o serviço só é inserido imediatamente antes ou depois de um dos
+     * seus k vizinhos mais próximos, em vez de em todas as posições de todas as rotas.
+     * Um serviço cuja última varredura não encontrou melhoria só é reavaliado contra as rotas
+     * alteradas desde então (ou contra todas, se a sua própria rota mudou); na varredura completa,
+     * as rotas sem capacidade residual para o serviço são puladas pelo índice de capacidade.
+     * @param granular Usa a vizinhança granular, se as listas de vizinhos estiverem ativas.
+     * @return True se uma melhoria foi encontrada e aplicada, false caso contrário.
+     */
+    bool tryRelocate(Solution& solution, SearchState& state, bool granular) {
+        const ServiceTable& table = *serviceTable;
+        granular = granular && neighbourCount > 0;
+        vector<size_t> targets;
+        for (size_t r1_idx = 0; r1_idx < solution.routes.size(); ++r1_idx) {
+            for (size_t s_idx = 0; s_idx < solution.routes[r1_idx].services.size(); ++s_idx) {
+                uint32_t service_to_move = solution.routes[r1_idx].services[s_idx];
+                size_t& scanned = state.relocateScan[granular][serviceOf(service_to_move)];
+                int demand = table.demand[serviceOf(service_to_move)];
+                if (granular) {
+                    if (!neighbourhoodChangedSince(state, serviceOf(service_to_move), scanned)) continue;
+                    long long removal_delta = removalDelta(solution.routes[r1_idx].services, s_idx);
+                    const uint32_t* near = &neighbourList[serviceOf(service_to_move) * neighbourCount];
+                    for (size_t c = 0; c < neighbourCount; ++c) {
+                        size_t r2_idx = state.routeOf[near[c]];
+                        if (r2_idx == r1_idx || solution.routes[r2_idx].totalDemand + demand > capacity) continue;
+                        const vector<uint32_t>& r2 = solution.routes[r2_idx].services;
+                        for (size_t pos = state.posOf[near[c]]; pos <= (size_t)state.posOf[near[c]] + 1; ++pos) {
+                            long long insertion_delta = insertionDelta(r2, pos, service_to_move);
+                            if (removal_delta + insertion_delta < 0) {
+                                applyRelocate(solution, state, r1_idx, s_idx, r2_idx, pos, removal_delta, insertion_delta);
+                                return true;
+                            }
+                        }
+                    }
+                    scanned = state.version;
+                    continue;
+                }
+                bool sourceChanged = state.routeStamp[r1_idx] > scanned;
+                if (!sourceChanged) {
+                    routesChangedSince(state, scanned, solution.routes.size(), targets);
+                    if (targets.empty()) continue;
+                }
+                long long removal_delta = removalDelta(solution.routes[r1_idx].services, s_idx);
+                auto tryTarget = [&](size_t r2_idx) {
+                    if (r1_idx == r2_idx) return false;
+                    const vector<uint32_t>& r2 = solution.routes[r2_idx].services;
+                    for (size_t pos = 0; pos <= r2.size(); ++pos) {
+                        long long insertion_delta = insertionDelta(r2, pos, service_to_move);
+                        if (removal_delta + insertion_delta < 0) {
+                            applyRelocate(solution, state, r1_idx, s_idx, r2_idx, pos, removal_delta, insertion_delta);
+                            return true;
+                        }
+                    }
+                    return false;
+                };
+                if (sourceChanged) {
+                    // Só as rotas com capacidade residual suficiente são visitadas
+                    if (state.capacityIndex.forEachWithResidual(demand, tryTarget)) return true;
+                } else {
+                    for (size_t r2_idx : targets) {
+                        if (solution.routes[r2_idx].totalDemand + demand > capacity) continue;
+                        if (tryTarget(r2_idx)) return true;
+                    }
+                }
+                scanned = state.version;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Tenta trocar (swap) um serviço de uma rota com um serviço de outra.
+     * Cada par é avaliado em O(1) a partir dos vizinhos dos dois serviços.
+     * Com vizinhança granular, cada serviço só é trocado com um vizinho próximo ou com os serviços
+     * adjacentes a ele, de modo a ficar ao lado do vizinho.
+     * Como no Relocate, pares de rotas já varridos sem melhoria só são reavaliados se uma delas mudou.
+     * @param granular Usa a vizinhança granular, se as listas de vizinhos estiverem ativas.
+     * @return True se uma melhoria foi encontrada e aplicada, false caso contrário.
+     */
+    bool trySwap(Solution& solution, SearchState& state, bool granular) {
+        const ServiceTable& table = *serviceTable;
+        auto feasible = [&](size_t r1_idx, uint32_t s1, size_t r2_idx, uint32_t s2) {
+            return solution.routes[r1_idx].totalDemand - table.demand[serviceOf(s1)] + table.demand[serviceOf(s2)] <= capacity &&
+                   solution.routes[r2_idx].totalDemand - table.demand[serviceOf(s2)] + table.demand[serviceOf(s1)] <= capacity;
+        };
+        if (granular && neighbourCount > 0) {
+            for (size_t r1_idx = 0; r1_idx < solution.routes.size(); ++r1_idx) {
+                for (size_t s1_idx = 0; s1_idx < solution.routes[r1_idx].services.size(); ++s1_idx) {
+                    uint32_t s1 = solution.routes[r1_idx].services[s1_idx];
+                    size_t& scanned = state.swapScanGranular[serviceOf(s1)];
+                    if (!neighbourhoodChangedSince(state, serviceOf(s1), scanned)) continue;
+                    const uint32_t* near = &neighbourList[serviceOf(s1) * neighbourCount];
+                    for (size_t c = 0; c < neighbourCount; ++c) {
+                        size_t r2_idx = state.routeOf[near[c]];
+                        if (r2_idx == r1_idx) continue;
+                        const vector<uint32_t>& r2 = solution.routes[r2_idx].services;
+                        size_t p = state.posOf[near[c]];
+                        for (size_t s2_idx = (p == 0 ? 0 : p - 1); s2_idx <= p + 1 && s2_idx < r2.size(); ++s2_idx) {
+                            uint32_t s2 = r2[s2_idx];
+                            if (!feasible(r1_idx, s1, r2_idx, s2)) continue;
+                            long long delta1 = replacementDelta(solution.routes[r1_idx].services, s1_idx, s2);
+                            long long delta2 = replacementDelta(r2, s2_idx, s1);
+                            if (delta1 + delta2 < 0) {
+                                applySwap(solution, state, r1_idx, s1_idx, r2_idx, s2_idx, delta1, delta2);
+                                return true;
+                            }
+                        }
+                    }
+                    scanned = state.version;
+                }
+            }
+            return false;
+        }
+        vector<size_t> partners;
+        for (size_t r1_idx = 0; r1_idx < solution.routes.size(); ++r1_idx) {
+            size_t& scanned = state.swapScan[r1_idx];
+            if (state.routeStamp[r1_idx] > scanned) {
+                partners.clear();
+                for (size_t r = r1_idx + 1; r < solution.routes.size(); ++r) partners.push_back(r);
+            } else {
+                routesChangedSince(state, scanned, solution.routes.size(), partners);
+                partners.erase(partners.begin(), upper_bound(partners.begin(), partners.end(), r1_idx));
+            }
+            for (size_t r2_idx : partners) {
+                const vector<uint32_t>& r1 = solution.routes[r1_idx].services;
+                const vector<uint32_t>& r2 = solution.routes[r2_idx].services;
+                for (size_t s1_idx = 0; s1_idx < r1.size(); ++s1_idx) {
+                    for (size_t s2_idx = 0; s2_idx < r2.size(); ++s2_idx) {
+                        if (!feasible(r1_idx, r1[s1_idx], r2_idx, r2[s2_idx])) continue;
+                        long long delta1 = replacementDelta(r1, s1_idx, r2[s2_idx]);
+                        long long delta2 = replacementDelta(r2, s2_idx, r1[s1_idx]);
+                        if (delta1 + delta2 < 0) {
+                            applySwap(solution, state, r1_idx, s1_idx, r2_idx, s2_idx, delta1, delta2);
+                            return true;
+                        }
+                    }
+                }
+            }
+            scanned = state.version;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Avalia a vizinhança em blocos paralelos e reduz ao melhor movimento.
+     * 'evaluate(unit, best)' examina uma unidade de trabalho (um par de rotas ou uma rota) e
+     * atualiza o melhor movimento da thread; a redução usa a ordem total de Move::betterThan.
+     */
+    template <typename Evaluate>
+    Move findBestMove(size_t units, Evaluate evaluate) {
+        // No multi-start e no memético, as threads já estão ocupadas com as partidas ou com os filhos
+        unsigned threads = config.starts > 1 || config.metaheuristic == Metaheuristic::Memetic ? 1 : max(1, config.searchThreads);
+        if (threads > 1 && (!searchPool || searchPool->size() != threads)) searchPool = make_unique<ThreadPool>(threads);
+        if (threads == 1) {
+            Move best;
+            for (size_t unit = 0; unit < units; ++unit) evaluate(unit, best);
+            return best;
+        }
+        vector<Move> best(threads);
+        searchPool->parallelFor(units, 64, [&](size_t begin, size_t end, unsigned id) {
+            for (size_t unit = begin; unit < end; ++unit) evaluate(unit, best[id]);
+        });
+        for (unsigned id = 1; id < threads; ++id) {
+            if (best[id].betterThan(best[0])) best[0] = best[id];
+        }
+        return best[0];
+    }
+
+    /**
+     * @brief Considera um movimento candidato: só os que melhoram o custo podem substituir o melhor.
+     */
+    static void consider(Move& best, Move::Type type, size_t r1, size_t i1, size_t r2, size_t i2, long long delta1, long long delta2) {
+        if (delta1 + delta2 >= 0) return;
+        Move candidate{type, delta1, delta2, r1, i1, r2, i2};
+        if (candidate.betterThan(best)) best = candidate;
+    }
+
+    /**
+     * @brief Melhor Relocate da solução. Na vizinhança completa, cada unidade de trabalho é um par
+     * ordenado de rotas (r1, r2); na granular, é uma rota de origem com os vizinhos dos seus serviços.
+     * 'consider' decide quais candidatos podem se tornar o melhor (por padrão, só os que melhoram).
+     */
+    template <typename Consider = decltype(&Solver::consider)>
+    Move findBestRelocate(const Solution& solution, const SearchState& state, bool granular, Consider consider = &Solver::consider) {
+        const ServiceTable& table = *serviceTable;
+        const size_t numRoutes = solution.routes.size();
+        if (granular && neighbourCount > 0) {
+            return findBestMove(numRoutes, [&](size_t r1_idx, Move& best) {
+                const vector<uint32_t>& r1 = solution.routes[r1_idx].services;
+                for (size_t s_idx = 0; s_idx < r1.size(); ++s_idx) {
+                    uint32_t s = r1[s_idx];
+                    long long removal_delta = removalDelta(r1, s_idx);
+                    const uint32_t* near = &neighbourList[serviceOf(s) * neighbourCount];
+                    for (size_t c = 0; c < neighbourCount; ++c) {
+                        size_t r2_idx = state.routeOf[near[c]];
+                        if (r2_idx == r1_idx || solution.routes[r2_idx].totalDemand + table.demand[serviceOf(s)] > capacity) continue;
+                        for (size_t pos = state.posOf[near[c]]; pos <= (size_t)state.posOf[near[c]] + 1; ++pos) {
+                            consider(best, Move::RELOCATE, r1_idx, s_idx, r2_idx, pos, removal_delta,
+                                     insertionDelta(solution.routes[r2_idx].services, pos, s));
+                        }
+                    }
+                }
+            });
+        }
+        return findBestMove(numRoutes * numRoutes, [&](size_t pair, Move& best) {
+            size_t r1_idx = pair / numRoutes, r2_idx = pair % numRoutes;
+            if (r1_idx == r2_idx) return;
+            const vector<uint32_t>& r1 = solution.routes[r1_idx].services;
+            const vector<uint32_t>& r2 = solution.routes[r2_idx].services;
+            for (size_t s_idx = 0; s_idx < r1.size(); ++s_idx) {
+                uint32_t s = r1[s_idx];
+                if (solution.routes[r2_idx].totalDemand + table.demand[serviceOf(s)] > capacity) continue;
+                long long removal_delta = removalDelta(r1, s_idx);
+                for (size_t pos = 0; pos <= r2.size(); ++pos) {
+                    consider(best, Move::RELOCATE, r1_idx, s_idx, r2_idx, pos, removal_delta, insertionDelta(r2, pos, s));
+                }
+            }
+        });
+    }
+
+    /**
+     * @brief Melhor Swap da solução, com a mesma divisão do trabalho de findBestRelocate
+     * (na vizinhança completa, só os pares r1 < r2 são avaliados).
+     */
+    template <typename Consider = decltype(&Solver::consider)>
+    Move findBestSwap(const Solution& solution, const SearchState& state, bool granular, Consider consider = &Solver::consider) {
+        const ServiceTable& table = *serviceTable;
+        const size_t numRoutes = solution.routes.size();
+        auto feasible = [&](size_t r1_idx, uint32_t s1, size_t r2_idx, uint32_t s2) {
+            return solution.routes[r1_idx].totalDemand - table.demand[serviceOf(s1)] + table.demand[serviceOf(s2)] <= capacity &&
+                   solution.routes[r2_idx].totalDemand - table.demand[serviceOf(s2)] + table.demand[serviceOf(s1)] <= capacity;
+        };
+        if (granular && neighbourCount > 0) {
+            return findBestMove(numRoutes, [&](size_t r1_idx, Move& best) {
+                const vector<uint32_t>& r1 = solution.routes[r1_idx].services;
+                for (size_t s1_idx = 0; s1_idx < r1.size(); ++s1_idx) {
+                    const uint32_t* near = &neighbourList[serviceOf(r1[s1_idx]) * neighbourCount];
+                    for (size_t c = 0; c < neighbourCount; ++c) {
+                        size_t r2_idx = state.routeOf[near[c]];
+                        if (r2_idx == r1_idx) continue;
+                        const vector<uint32_t>& r2 = solution.routes[r2_idx].services;
+                        size_t p = state.posOf[near[c]];
+                        for (size_t s2_idx = (p == 0 ? 0 : p - 1); s2_idx <= p + 1 && s2_idx < r2.size(); ++s2_idx) {
+                            if (!feasible(r1_idx, r1[s1_idx], r2_idx, r2[s2_idx])) continue;
+                            // O par é registrado com a rota de menor índice primeiro, como na vizinhança completa
+                            long long delta1 = replacementDelta(r1, s1_idx, r2[s2_idx]);
+                            long long delta2 = replacementDelta(r2, s2_idx, r1[s1_idx]);
+                            if (r1_idx < r2_idx) consider(best, Move::SWAP, r1_idx, s1_idx, r2_idx, s2_idx, delta1, delta2);
+                            else consider(best, Move::SWAP, r2_idx, s2_idx, r1_idx, s1_idx, delta2, delta1);
+                        }
+                    }
+                }
+            });
+        }
+        return findBestMove(numRoutes * numRoutes, [&](size_t pair, Move& best) {
+            size_t r1_idx = pair / numRoutes, r2_idx = pair % numRoutes;
+            if (r1_idx >= r2_idx) return;
+            const vector<uint32_t>& r1 = solution.routes[r1_idx].services;
+            const vector<uint32_t>& r2 = solution.routes[r2_idx].services;
+            for (size_t s1_idx = 0; s1_idx < r1.size(); ++s1_idx) {
+                for (size_t s2_idx = 0; s2_idx < r2.size(); ++s2_idx) {
+                    if (!feasible(r1_idx, r1[s1_idx], r2_idx, r2[s2_idx])) continue;
+                    consider(best, Move::SWAP, r1_idx, s1_idx, r2_idx, s2_idx,
+                             replacementDelta(r1, s1_idx, r2[s2_idx]), replacementDelta(r2, s2_idx, r1[s1_idx]));
+                }
+            }
+        });
+    }
+
+    /**
+     * @brief Aplica um movimento encontrado por findBestRelocate ou findBestSwap.
+     */
+    void applyMove(Solution& solution, SearchState& state, const Move& move) {
+        if (move.type == Move::RELOCATE) {
+            applyRelocate(solution, state, move.r1, move.i1, move.r2, move.i2, move.delta1, move.delta2);
+        } else if (move.type == Move::SWAP) {
+            applySwap(solution, state, move.r1, move.i1, move.r2, move.i2, move.delta1, move.delta2);
+        }
+    }
+
+    /**
+     * @brief Somas prefixadas dos deslocamentos internos da rota no sentido original ('forward') e com
+     * cada par de visitas consecutivas percorrido ao contrário ('backward'), usadas para avaliar inversões em O(1).
+     */
+    void reversalPrefixes(const vector<uint32_t>& route, vector<long long>& forward, vector<long long>& backward) const {
+        const ServiceTable& table = *serviceTable;
+        forward.assign(route.size(), 0);
+        backward.assign(route.size(), 0);
+        for (size_t t = 1; t < route.size(); ++t) {
+            forward[t] = forward[t - 1] + dist(table.endOf(route[t - 1]), table.startOf(route[t]));
+            backward[t] = backward[t - 1] + dist(table.endOf(table.reversed(route[t])), table.startOf(table.reversed(route[t - 1])));
+        }
+    }
+
+    /**
+     * @brief Variação do custo da rota ao inverter o trecho [i, j], em O(1) com as somas de reversalPrefixes.
+     */
+    long long reversalDelta(const vector<uint32_t>& route, const vector<long long>& forward, const vector<long long>& backward,
+                            size_t i, size_t j) const {
+        const ServiceTable& table = *serviceTable;
+        int before = endNodeBefore(route, i), after = startNodeAt(route, j + 1);
+        return dist(before, table.startOf(table.reversed(route[j]))) + dist(table.endOf(table.reversed(route[i])), after)
+             + (backward[j] - backward[i])
+             - dist(before, table.startOf(route[i])) - dist(table.endOf(route[j]), after) - (forward[j] - forward[i]);
+    }
+
+    /**
+     * @brief Inverte o trecho [i, j] da rota (arestas trocam de sentido) e atualiza custo e índice.
+     */
+    void applyReversal(Solution& solution, SearchState& state, size_t r_idx, size_t i, size_t j, long long delta) {
+        vector<uint32_t>& route = solution.routes[r_idx].services;
+        reverse(route.begin() + i, route.begin() + j + 1);
+        for (size_t t = i; t <= j; ++t) route[t] = serviceTable->reversed(route[t]);
+        updateRoute(solution, r_idx, delta, 0);
+        indexRoute(solution, state, r_idx);
+    }
+
+    /**
+     * @brief Aplica a heurística 2-opt para otimizar o caminho DENTRO de cada rota.
+     * Inverter o trecho [i, j] percorre seus serviços na ordem oposta e cada aresta ('E') no sentido
+     * oposto (arcos mantêm o sentido). Com as somas prefixadas dos deslocamentos internos no sentido
+     * original ('forward') e no invertido ('backward'), cada par (i, j) é avaliado em O(1); i == j
+     * apenas troca o sentido de uma aresta. Cada rota recebe varreduras O(n²) completas, aplicando a
+     * melhor inversão de cada varredura, até não haver mais melhoria. Rotas que não mudaram desde
+     * a última varredura são puladas.
+     * @return True se alguma rota foi melhorada, false caso contrário.
+     */
+    bool try2Opt(Solution& solution, SearchState& state) {
+        const ServiceTable& table = *serviceTable;
+        bool improved = false;
+        vector<long long> forward, backward;
+        for (size_t r_idx = 0; r_idx < solution.routes.size(); ++r_idx) {
+            vector<uint32_t>& route = solution.routes[r_idx].services;
+            const size_t m = route.size();
+            if (m == 0 || state.routeStamp[r_idx] <= state.twoOptScan[r_idx]) continue;
+            while (!timeExpired()) {
+                reversalPrefixes(route, forward, backward);
+                long long best_delta = 0;
+                size_t best_i = 0, best_j = 0;
+                for (size_t i = 0; i < m; ++i) {
+                    int before = endNodeBefore(route, i);
+                    long long removed_in = dist(before, table.startOf(route[i]));
+                    int reversed_end = table.endOf(table.reversed(route[i]));
+                    for (size_t j = i; j < m; ++j) {
+                        int after = startNodeAt(route, j + 1);
+                        long long delta = dist(before, table.startOf(table.reversed(route[j]))) + dist(reversed_end, after)
+                                        + (backward[j] - backward[i])
+                                        - removed_in - dist(table.endOf(route[j]), after) - (forward[j] - forward[i]);
+                        if (delta < best_delta) {
+                            best_delta = delta;
+                            best_i = i;
+                            best_j = j;
+                        }
+                    }
+                }
+                if (best_delta >= 0) break;
+                applyReversal(solution, state, r_idx, best_i, best_j, best_delta);
+                improved = true;
+            }
+            if (!timeExpired()) state.twoOptScan[r_idx] = state.version;
+        }
+        return improved;
+    }
+
+    /**
+     * @brief Busca local de melhor melhoria: a cada passo aplica o melhor Relocate; se nenhum
+     * melhora, o melhor Swap; depois o 2-opt e, com vizinhança granular, as varreduras completas.
+     * As vizinhanças inter-rotas são avaliadas em paralelo com 'searchThreads' threads.
+     */
+    void bestImprovementSearch(Solution& solution, SearchState& state) {
+        while (!timeExpired()) {
+            Move move = findBestRelocate(solution, state, true);
+            if (move.type == Move::NONE) move = findBestSwap(solution, state, true);
+            if (move.type == Move::NONE && try2Opt(solution, state)) continue;
+            if (move.type == Move::NONE && neighbourCount > 0) move = findBestRelocate(solution, state, false);
+            if (move.type == Move::NONE && neighbourCount > 0) move = findBestSwap(solution, state, false);
+            if (move.type == Move::NONE) break;
+            applyMove(solution, state, move);
+        }
+    }
+
+    /**
+     * @brief (Etapa 3) Executa uma busca local baseada em vizinhanças variáveis (VNS).
+     * Aplica repetidamente os movimentos Relocate, Swap e 2-opt até que nenhuma melhoria seja possível.
+     * Com vizinhança granular, a descida usa só os movimentos entre vizinhos próximos; uma varredura
+     * completa de Relocate e Swap só é feita para sair de um ótimo local da vizinhança granular.
+     * @param solution A solução a ser otimizada.
+     */
+    void localSearch(Solution& solution) {
+        ensureNeighbourLists();
+        SearchState state = buildSearchState(solution);
+        if (config.bestImprovement) {
+            bestImprovementSearch(solution, state);
+            return;
+        }
+        bool improvement = true;
+        while(improvement && !timeExpired()){
+            improvement = false;
+            if (tryRelocate(solution, state, true)) {
+                improvement = true;
+                continue;
+            }
+            if (trySwap(solution, state, true)) {
+                improvement = true;
+                continue;
+            }
+            if (try2Opt(solution, state)) {
+                improvement = true;
+                continue;
+            }
+            if (neighbourCount > 0 && (tryRelocate(solution, state, false) || trySwap(solution, state, false))) {
+                improvement = true;
+                continue;
+            }
+        }
+    }
+
+    /**
+     * @brief Perturba a solução com 'strength' relocates aleatórios, sem olhar o custo.
+     * Cada serviço sorteado vai para uma posição aleatória de outra rota sorteada que o comporte
+     * ou, se ela não o comportar, para uma rota nova.
+     */
+    void perturb(Solution& solution, int strength, mt19937& random) {
+        const ServiceTable& table = *serviceTable;
+        for (int k = 0; k < strength && solution.routes.size() > 0; ++k) {
+            size_t r1_idx = uniform_int_distribution<size_t>(0, solution.routes.size() - 1)(random);
+            size_t s_idx = uniform_int_distribution<size_t>(0, solution.routes[r1_idx].services.size() - 1)(random);
+            uint32_t s = solution.routes[r1_idx].services[s_idx];
+            size_t r2_idx = uniform_int_distribution<size_t>(0, solution.routes.size() - 1)(random);
+            bool fits = r2_idx != r1_idx && solution.routes[r2_idx].totalDemand + table.demand[serviceOf(s)] <= capacity;
+            if (!fits && solution.routes[r1_idx].services.size() == 1) continue;
+
+            long long removal_delta = removalDelta(solution.routes[r1_idx].services, s_idx);
+            solution.routes[r1_idx].services.erase(solution.routes[r1_idx].services.begin() + s_idx);
+            updateRoute(solution, r1_idx, removal_delta - table.cost[serviceOf(s)], -table.demand[serviceOf(s)]);
+            if (fits) {
+                vector<uint32_t>& r2 = solution.routes[r2_idx].services;
+                size_t pos = uniform_int_distribution<size_t>(0, r2.size())(random);
+                long long insertion_delta = insertionDelta(r2, pos, s);
+                r2.insert(r2.begin() + pos, s);
+                updateRoute(solution, r2_idx, insertion_delta + table.cost[serviceOf(s)], table.demand[serviceOf(s)]);
+            } else {
+                Route route;
+                route.id = 0;
+                route.services.push_back(s);
+                solution.routes.push_back(route);
+                updateRoute(solution, solution.routes.size() - 1, calculateRouteCost(route.services), table.demand[serviceOf(s)]);
+            }
+            removeRouteIfEmpty(solution, r1_idx);
+        }
+    }
+
+    /**
+     * @brief Publica um custo na incumbente compartilhada, se for menor que o atual (sem travas).
+     * @return True se a incumbente foi melhorada.
+     */
+    static bool publishIncumbent(atomic<long long>& incumbent, long long cost) {
+        long long current = incumbent.load();
+        while (cost < current) {
+            if (incumbent.compare_exchange_weak(current, cost)) return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Indica se a partida ainda pode continuar a busca local iterada.
+     */
+    bool hasBudget(const SearchRun& run) const {
+        bool budgeted = config.timeLimitSeconds > 0 || config.maxIterations > 0;
+        return budgeted && !run.abandoned && !timeExpired() &&
+               (config.maxIterations == 0 || run.iteration < config.maxIterations);
+    }
+
+    /**
+     * @brief Executa até 'count' iterações da busca local iterada (ILS) numa partida: perturba a solução
+     * corrente, reaplica a busca local e aceita o resultado se for melhor que a corrente. A força da
+     * perturbação cresce enquanto a melhor solução da partida não melhora, e a cada 100 iterações sem
+     * melhoria a partida recomeça da sua melhor solução. Cada nova melhor é publicada na incumbente.
+     * @param start O início de solve(), para registrar o instante em que a melhor foi encontrada.
+     */
+    void iteratedLocalSearch(SearchRun& run, long long count, chrono::steady_clock::time_point start,
+                             atomic<long long>& incumbent) {
+        const int maxStrength = max<int>(2, serviceTable->size() / 4);
+        for (long long k = 0; k < count && hasBudget(run); ++k) {
+            ++run.iteration;
+            Solution candidate = run.current;
+            perturb(candidate, min<int>(maxStrength, 2 + run.stall / 20), run.random);
+            localSearch(candidate);
+            if (candidate.totalCost < run.current.totalCost) run.current = move(candidate);
+            if (run.current.totalCost < run.best.totalCost) {
+                run.best = run.current;
+                recordBest(run.best, start);
+                run.stall = 0;
+                if (publishIncumbent(incumbent, run.best.totalCost)) {
+                    log("ILS: nova melhor solução na iteração " + to_string(run.iteration) + ": " + to_string(run.best.totalCost));
+                }
+            } else if (++run.stall % 100 == 0) {
+                run.current = run.best;
+            }
+        }
+    }
+
+    /**
+     * @brief Busca local seguida, se houver orçamento de tempo ou de iterações, da busca local iterada
+     * até o orçamento acabar.
+     * Com 'starts' > 1, várias partidas independentes rodam em 'searchThreads' threads: cada uma
+     * embaralha a ordem das rotas iniciais com a sua semente (seed + i; a partida 0 mantém a ordem)
+     * ou, com o path-scanning aleatório, constrói a sua própria solução de partida. Com uma partida a
+     * quente (setWarmStart), todas partem da solução carregada, embaralhada como acima.
+     * As partidas avançam em etapas de 50 iterações e publicam suas melhores numa incumbente
+     * atômica; ao fim de cada etapa, as que estão piores que a incumbente por mais que 'abandonGap'
+     * são abandonadas. Como a decisão só é tomada entre etapas, o resultado com orçamento de
+     * iterações não depende do número de threads nem da ordem de execução.
+     * @param start O início de solve(), para registrar o instante em que a melhor foi encontrada.
+     * @return A melhor solução encontrada (no empate, a da partida de menor índice).
+     */
+    Solution multiStartSearch(const Solution& solution, chrono::steady_clock::time_point start) {
+        const size_t starts = max(1, config.starts);
+        ThreadPool pool(min<size_t>(starts, max(1, config.searchThreads)));
+        atomic<long long> incumbent{INF};
+        vector<SearchRun> runs(starts);
+        pool.parallelFor(starts, 1, [&](size_t begin, size_t end, unsigned) {
+            for (size_t i = begin; i < end; ++i) {
+                SearchRun& run = runs[i];
+                run.random.seed(config.seed + i);
+                if (i > 0 && config.construction == Construction::PathScanningRandom && !hasWarmStart) {
+                    run.current = constructSolution(run.random);
+                } else {
+                    run.current = solution;
+                    if (i > 0) shuffle(run.current.routes.begin(), run.current.routes.end(), run.random);
+                }
+                localSearch(run.current);
+                run.best = run.current;
+                recordBest(run.best, start);
+                publishIncumbent(incumbent, run.best.totalCost);
+            }
+        });
+        vector<size_t> active;
+        while (true) {
+            active.clear();
+            for (size_t i = 0; i < starts; ++i) if (hasBudget(runs[i])) active.push_back(i);
+            if (active.empty()) break;
+            pool.parallelFor(active.size(), 1, [&](size_t begin, size_t end, unsigned) {
+                for (size_t a = begin; a < end; ++a) iteratedLocalSearch(runs[active[a]], 50, start, incumbent);
+            });
+            long long best = incumbent.load();
+            for (size_t i : active) {
+                if (config.abandonGap > 0 && runs[i].best.totalCost > best * (1.0 + config.abandonGap)) {
+                    runs[i].abandoned = true;
+                    log("Multi-start: partida " + to_string(i) + " abandonada com custo " + to_string(runs[i].best.totalCost));
+                }
+            }
+        }
+        size_t winner = 0;
+        for (size_t i = 1; i < starts; ++i) {
+            if (runs[i].best.totalCost < runs[winner].best.totalCost) winner = i;
+        }
+        if (starts > 1) log("Multi-start: melhor solução da partida " + to_string(winner) + " de " + to_string(starts));
+        return move(runs[winner].best);
+    }
+
+    /**
+     * @brief Crossover OX sobre tours gigantes: copia um trecho aleatório do primeiro pai na mesma
+     * posição e completa o filho, a partir do fim do trecho e circularmente, com os serviços restantes
+     * na ordem do segundo pai. Cada serviço mantém o sentido do pai de onde veio.
+     */
+    static vector<uint32_t> orderCrossover(const vector<uint32_t>& first, const vector<uint32_t>& second, mt19937& random) {
+        const size_t n = first.size();
+        if (n < 2) return first;
+        size_t a = uniform_int_distribution<size_t>(0, n - 1)(random);
+        size_t b = uniform_int_distribution<size_t>(0, n - 1)(random);
+        if (a > b) swap(a, b);
+        vector<uint32_t> child(n);
+        vector<char> used(n, 0);
+        for (size_t i = a; i <= b; ++i) {
+            child[i] = first[i];
+            used[serviceOf(first[i])] = 1;
+        }
+        size_t pos = (b + 1) % n;
+        for (size_t k = 0; k < n; ++k) {
+            uint32_t visit = second[(b + 1 + k) % n];
+            if (used[serviceOf(visit)]) continue;
+            child[pos] = visit;
+            pos = (pos + 1) % n;
+        }
+        return child;
+    }
+
+    /**
+     * @brief Monta um indivíduo a partir de uma solução, registrando os vizinhos de cada serviço.
+     */
+    Individual makeIndividual(Solution solution) const {
+        Individual individual;
+        individual.pred.assign(serviceTable->size(), -1);
+        individual.succ.assign(serviceTable->size(), -1);
+        for (const auto& route : solution.routes) {
+            for (size_t p = 0; p < route.services.size(); ++p) {
+                uint32_t s = serviceOf(route.services[p]);
+                if (p > 0) individual.pred[s] = serviceOf(route.services[p - 1]);
+                if (p + 1 < route.services.size()) individual.succ[s] = serviceOf(route.services[p + 1]);
+            }
+        }
+        individual.solution = move(solution);
+        return individual;
+    }
+
+    /**
+     * @brief Distância de pares quebrados: fração dos serviços cujos vizinhos em 'a' não são
+     * vizinhos também em 'b' (a adjacência é tomada sem sentido, porque arestas podem ser invertidas).
+     */
+    static double brokenPairsDistance(const Individual& a, const Individual& b) {
+        size_t broken = 0;
+        for (size_t s = 0; s < a.succ.size(); ++s) {
+            if (a.succ[s] != b.succ[s] && a.succ[s] != b.pred[s]) broken++;
+        }
+        return a.succ.empty() ? 0.0 : (double)broken / a.succ.size();
+    }
+
+    /**
+     * @brief Aptidão enviesada de cada indivíduo (menor é melhor): a posição no ranking de custo mais,
+     * com peso (1 - elite / tamanho), a posição no ranking da contribuição à diversidade, que é a
+     * distância média aos três indivíduos mais próximos. Assim, indivíduos bons mas parecidos com
+     * outros perdem para indivíduos um pouco piores que trazem estrutura nova.
+     */
+    static vector<double> biasedFitness(const vector<Individual>& population) {
+        const size_t size = population.size();
+        const size_t elite = 4, closest = 3;
+        vector<double> fitness(size, 0.0);
+        if (size < 2) return fitness;
+        vector<double> contribution(size, 0.0);
+        for (size_t i = 0; i < size; ++i) {
+            vector<double> d;
+            for (size_t j = 0; j < size; ++j) if (j != i) d.push_back(brokenPairsDistance(population[i], population[j]));
+            size_t k = min(closest, d.size());
+            partial_sort(d.begin(), d.begin() + k, d.end());
+            for (size_t c = 0; c < k; ++c) contribution[i] += d[c] / k;
+        }
+        vector<size_t> byCost(size), byDiversity(size);
+        for (size_t i = 0; i < size; ++i) byCost[i] = byDiversity[i] = i;
+        stable_sort(byCost.begin(), byCost.end(), [&](size_t a, size_t b) { return population[a].solution.totalCost < population[b].solution.totalCost; });
+        stable_sort(byDiversity.begin(), byDiversity.end(), [&](size_t a, size_t b) { return contribution[a] > contribution[b]; });
+        const double diversityWeight = 1.0 - (double)min(elite, size) / size;
+        for (size_t rank = 0; rank < size; ++rank) {
+            fitness[byCost[rank]] += (double)rank / (size - 1);
+            fitness[byDiversity[rank]] += diversityWeight * rank / (size - 1);
+        }
+        return fitness;
+    }
+
+    /**
+     * @brief Reduz a população a 'target' indivíduos: remove primeiro os clones (distância zero a um
+     * indivíduo de custo menor ou igual) e depois os de pior aptidão enviesada. O de menor custo nunca sai.
+     */
+    void selectSurvivors(vector<Individual>& population, size_t target) const {
+        while (population.size() > target) {
+            size_t best = 0;
+            for (size_t i = 1; i < population.size(); ++i) {
+                if (population[i].solution.totalCost < population[best].solution.totalCost) best = i;
+            }
+            size_t victim = population.size();
+            for (size_t i = 0; i < population.size() && victim == population.size(); ++i) {
+                for (size_t j = 0; j < population.size(); ++j) {
+                    if (i != j && i != best && population[j].solution.totalCost <= population[i].solution.totalCost &&
+                        brokenPairsDistance(population[i], population[j]) == 0.0) {
+                        victim = i;
+                        break;
+                    }
+                }
+            }
+            if (victim == population.size()) {
+                vector<double> fitness = biasedFitness(population);
+                for (size_t i = 0; i < population.size(); ++i) {
+                    if (i != best && (victim == population.size() || fitness[i] > fitness[victim])) victim = i;
+                }
+            }
+            population.erase(population.begin() + victim);
+        }
+    }
+
+    /**
+     * @brief Algoritmo memético: uma população de soluções educadas pela busca local evolui por
+     * crossover OX dos tours gigantes, decodificados em rotas pelo Split. A cada geração, 'population' / 2
+     * filhos são gerados e educados em paralelo em 'searchThreads' threads (cada filho com uma semente
+     * derivada da geração e do seu índice, e inseridos na ordem dos índices, para que o resultado não
+     * dependa do número de threads); depois a seleção de sobreviventes volta a população ao tamanho
+     * original, equilibrando custo e diversidade. Após 50 gerações sem melhoria, a população é
+     * reiniciada com tours aleatórios, mantendo a melhor solução.
+     * Os pais são escolhidos por torneio binário na aptidão enviesada. Cada filho conta como uma
+     * iteração do orçamento; sem orçamento, a busca termina após 50 gerações sem melhoria.
+     * @param initial A solução construída, primeiro indivíduo da população.
+     * @param start O início de solve(), para registrar o instante em que a melhor foi encontrada.
+     */
+    Solution memeticSearch(const Solution& initial, chrono::steady_clock::time_point start) {
+        const size_t populationSize = max(2, config.population);
+        const size_t offspring = max<size_t>(1, populationSize / 2);
+        const long long maxStall = 50;
+        const bool budgeted = config.timeLimitSeconds > 0 || config.maxIterations > 0;
+        ThreadPool pool(max(1, config.searchThreads));
+        long long iteration = 0;
+
+        // Gera 'count' indivíduos em paralelo; 'make(i, random)' produz a solução ainda não educada do i-ésimo
+        auto breed = [&](size_t count, size_t generation, auto make) {
+            vector<Individual> children(count);
+            pool.parallelFor(count, 1, [&](size_t begin, size_t end, unsigned) {
+                for (size_t i = begin; i < end; ++i) {
+                    seed_seq sequence{(size_t)config.seed, generation, i};
+                    mt19937 random(sequence);
+                    Solution child = make(i, random);
+                    localSearch(child);
+                    children[i] = makeIndividual(move(child));
+                }
+            });
+            return children;
+        };
+        auto randomTour = [&](size_t, mt19937& random) {
+            vector<uint32_t> tour = giantTour(initial);
+            shuffle(tour.begin(), tour.end(), random);
+            for (auto& visit : tour) if (random() & 1) visit = serviceTable->reversed(visit);
+            return split(tour);
+        };
+
+        Solution best = initial;
+        localSearch(best);
+        recordBest(best, start);
+        vector<Individual> population;
+        population.push_back(makeIndividual(best));
+        size_t generation = 0;
+        for (auto& individual : breed(populationSize - 1, generation++, randomTour)) population.push_back(move(individual));
+        for (const auto& individual : population) {
+            if (individual.solution.totalCost < best.totalCost) {
+                best = individual.solution;
+                recordBest(best, start);
+            }
+        }
+
+        long long stall = 0;
+        while (!timeExpired() && (config.maxIterations == 0 || iteration < config.maxIterations) && (budgeted || stall < maxStall)) {
+            size_t count = offspring;
+            if (config.maxIterations > 0) count = min<size_t>(count, config.maxIterations - iteration);
+            iteration += count;
+            vector<double> fitness = biasedFitness(population);
+            auto tournament = [&](mt19937& random) -> const Individual& {
+                size_t a = uniform_int_distribution<size_t>(0, population.size() - 1)(random);
+                size_t b = uniform_int_distribution<size_t>(0, population.size() - 1)(random);
+                return population[fitness[a] <= fitness[b] ? a : b];
+            };
+            vector<Individual> children = breed(count, generation++, [&](size_t, mt19937& random) {
+                const Individual& first = tournament(random);
+                const Individual& second = tournament(random);
+                return split(orderCrossover(giantTour(first.solution), giantTour(second.solution), random));
+            });
+            bool improved = false;
+            for (auto& child : children) {
+                if (child.solution.totalCost < best.totalCost) {
+                    best = child.solution;
+                    recordBest(best, start);
+                    improved = true;
+                    log("Memético: nova melhor solução na geração " + to_string(generation - 1) + ": " + to_string(best.totalCost));
+                }
+                population.push_back(move(child));
+            }
+            selectSurvivors(population, populationSize);
+            stall = improved ? 0 : stall + 1;
+            if (budgeted && stall > 0 && stall % maxStall == 0 && !timeExpired()) {
+                log("Memético: população reiniciada após " + to_string(maxStall) + " gerações sem melhoria");
+                population.clear();
+                population.push_back(makeIndividual(best));
+                for (auto& individual : breed(populationSize - 1, generation++, randomTour)) population.push_back(move(individual));
+            }
+        }
+        return best;
+    }
+
+    /**
+     * @brief Chave pseudoaleatória de 64 bits para o hash de soluções (splitmix64).
+     */
+    static uint64_t mixHash(uint64_t x) {
+        x += 0x9E3779B97F4A7C15ull;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    }
+
+    /**
+     * @brief Busca tabu sobre as vizinhanças Relocate e Swap. A cada iteração aplica o melhor movimento
+     * admissível, mesmo que piore a solução. O atributo tabu é o par (serviço, rota): quando um serviço sai
+     * de uma rota, voltar a ela fica proibido por 'tenure' iterações. Os prazos ficam num vetor plano
+     * indexado por serviço * rotas + id da rota (os ids são fixos durante a busca, já que Relocate e Swap
+     * não criam rotas), então cada verificação é O(1). O critério de aspiração libera um movimento tabu
+     * que leve a uma solução melhor que a melhor conhecida.
+     * Ciclos são detectados por um hash da solução (XOR de uma chave por par serviço-rota, atualizado
+     * em O(1) a cada movimento, combinado com o custo): rever uma solução já visitada aumenta o prazo
+     * tabu em 20%, e 100 iterações sem repetição o reduzem em 10%, até o valor inicial.
+     * Após 'maxStall' iterações sem melhoria, a busca recomeça da melhor solução perturbada. Cada
+     * iteração conta como uma do orçamento; sem orçamento, a busca termina no primeiro recomeço.
+     * @param initial A solução construída.
+     * @param start O início de solve(), para registrar o instante em que a melhor foi encontrada.
+     */
+    Solution tabuSearch(const Solution& initial, chrono::steady_clock::time_point start) {
+        const ServiceTable& table = *serviceTable;
+        const size_t n = table.size();
+        const long long maxStall = 200;
+        const bool budgeted = config.timeLimitSeconds > 0 || config.maxIterations > 0;
+        const double baseTenure = min<double>(30, max<double>(5, n / 10.0));
+        mt19937 random(config.seed);
+
+        Solution current = initial;
+        localSearch(current);
+        Solution best = current;
+        recordBest(best, start);
+
+        size_t numRoutes = 0;
+        vector<long long> tabuUntil;
+        uint64_t hash = 0;
+        SearchState state;
+        auto key = [&](uint32_t s, size_t routeId) { return mixHash((uint64_t)serviceOf(s) << 32 | routeId); };
+        // (Re)inicia a memória a partir da solução corrente: ids 0..R-1, prazos zerados e hash recalculado
+        auto reset = [&]() {
+            numRoutes = current.routes.size();
+            for (size_t r = 0; r < numRoutes; ++r) current.routes[r].id = r;
+            tabuUntil.assign(n * numRoutes, 0);
+            hash = 0;
+            for (const auto& route : current.routes) for (uint32_t s : route.services) hash ^= key(s, route.id);
+            state = buildSearchState(current);
+        };
+        reset();
+
+        unordered_map<uint64_t, long long> visited;
+        double tenure = baseTenure;
+        long long iteration = 0, stall = 0, lastRepeat = 0;
+        while (!timeExpired() && (config.maxIterations == 0 || iteration < config.maxIterations)) {
+            ++iteration;
+            auto isTabu = [&](uint32_t s, size_t r_idx) { return tabuUntil[serviceOf(s) * numRoutes + current.routes[r_idx].id] >= iteration; };
+            auto admissible = [&](Move& chosen, Move::Type type, size_t r1, size_t i1, size_t r2, size_t i2, long long delta1, long long delta2) {
+                Move candidate{type, delta1, delta2, r1, i1, r2, i2};
+                if (!candidate.betterThan(chosen)) return;
+                uint32_t s1 = current.routes[r1].services[i1];
+                bool tabu = type == Move::RELOCATE ? isTabu(s1, r2) : isTabu(s1, r2) || isTabu(current.routes[r2].services[i2], r1);
+                if (tabu && current.totalCost + delta1 + delta2 >= best.totalCost) return; // Aspiração
+                chosen = candidate;
+            };
+            Move move = findBestRelocate(current, state, true, admissible);
+            Move swapMove = findBestSwap(current, state, true, admissible);
+            if (swapMove.betterThan(move)) move = swapMove;
+            if (move.type == Move::NONE) break;
+
+            // Atributos tabu: o serviço que sai de uma rota não pode voltar a ela por 'tenure' iterações
+            long long until = iteration + (long long)tenure;
+            uint32_t s1 = current.routes[move.r1].services[move.i1];
+            size_t id1 = current.routes[move.r1].id, id2 = current.routes[move.r2].id;
+            tabuUntil[serviceOf(s1) * numRoutes + id1] = until;
+            hash ^= key(s1, id1) ^ key(s1, id2);
+            if (move.type == Move::SWAP) {
+                uint32_t s2 = current.routes[move.r2].services[move.i2];
+                tabuUntil[serviceOf(s2) * numRoutes + id2] = until;
+                hash ^= key(s2, id2) ^ key(s2, id1);
+            }
+            applyMove(current, state, move);
+
+            if (current.totalCost < best.totalCost) {
+                best = current;
+                recordBest(best, start);
+                stall = 0;
+                log("Tabu: nova melhor solução na iteração " + to_string(iteration) + ": " + to_string(best.totalCost));
+            } else {
+                stall++;
+            }
+
+            uint64_t signature = hash ^ mixHash(current.totalCost);
+            auto seen = visited.find(signature);
+            if (seen != visited.end()) {
+                tenure = min<double>(n / 2.0 + 1, tenure * 1.2);
+                lastRepeat = iteration;
+            } else if (iteration - lastRepeat >= 100) {
+                tenure = max(baseTenure, tenure * 0.9);
+                lastRepeat = iteration;
+            }
+            if (visited.size() > (1u << 20)) visited.clear();
+            visited[signature] = iteration;
+
+            if (stall >= maxStall) {
+                if (!budgeted) break;
+                current = best;
+                perturb(current, max<int>(2, n / 10), random);
+                localSearch(current);
+                if (current.totalCost < best.totalCost) {
+                    best = current;
+                    recordBest(best, start);
+                }
+                reset();
+                stall = 0;
+                tenure = baseTenure;
+            }
+        }
+        return best;
+    }
+
+    /**
+     * @brief Recozimento simulado: sorteia um Relocate, Swap ou 2-opt e o avalia em O(1) — os dois
+     * primeiros com as variações locais de removalDelta, insertionDelta e replacementDelta, o 2-opt com as
+     * somas prefixadas de cada rota, guardadas em cache e refeitas só quando a rota muda (pelo carimbo
+     * da rota). Movimentos que melhoram são sempre aceitos; os que pioram em 'delta', com probabilidade
+     * exp(-delta / T).
+     * O resfriamento é calibrado pelos próprios movimentos: numa amostra inicial, a mediana das pioras
+     * define T0 (aceitação de 50% dessa piora) e o percentil 5 define Tf (aceitação de 0,1%), e T decai
+     * geometricamente de T0 a Tf conforme
+     * a fração consumida do orçamento de tempo ou de iterações (cada movimento sorteado conta como uma
+     * iteração). Sem orçamento, são 1000 movimentos por serviço.
+     * A melhor solução é guardada (copiada só quando a trajetória deixa um novo mínimo) e, ao fim,
+     * polida pela busca local.
+     * @param initial A solução construída.
+     * @param start O início de solve(), para registrar o instante em que a melhor foi encontrada.
+     */
+    Solution simulatedAnnealing(const Solution& initial, chrono::steady_clock::time_point start) {
+        const ServiceTable& table = *serviceTable;
+        const uint32_t n = table.size();
+        if (n == 0) return initial; // Sem serviços não há movimento a sortear
+        mt19937 random(config.seed);
+        auto elapsed = [&]() { return chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count(); };
+
+        Solution current = initial;
+        localSearch(current);
+        Solution best = current;
+        recordBest(best, start);
+        SearchState state = buildSearchState(current);
+        vector<vector<long long>> forward(current.routes.size()), backward(current.routes.size());
+        vector<size_t> prefixStamp(current.routes.size(), SIZE_MAX);
+
+        // Sorteia um movimento; devolve false se o sorteio não produziu um movimento viável
+        enum { RELOCATE, SWAP, REVERSAL };
+        struct Sample { int type; size_t r1, i1, r2, i2; long long delta1, delta2; };
+        auto sample = [&](Sample& m) {
+            m.type = uniform_int_distribution<int>(0, 2)(random);
+            uint32_t s = uniform_int_distribution<uint32_t>(0, n - 1)(random);
+            m.r1 = state.routeOf[s];
+            m.i1 = state.posOf[s];
+            const vector<uint32_t>& r1 = current.routes[m.r1].services;
+            if (m.type == REVERSAL) {
+                if (prefixStamp[m.r1] != state.routeStamp[m.r1]) {
+                    reversalPrefixes(r1, forward[m.r1], backward[m.r1]);
+                    prefixStamp[m.r1] = state.routeStamp[m.r1];
+                }
+                m.r2 = m.r1;
+                m.i2 = uniform_int_distribution<size_t>(0, r1.size() - 1)(random);
+                if (m.i1 > m.i2) swap(m.i1, m.i2);
+                m.delta1 = reversalDelta(r1, forward[m.r1], backward[m.r1], m.i1, m.i2);
+                m.delta2 = 0;
+                return true;
+            }
+            // Com vizinhança granular, o parceiro é um dos vizinhos próximos de 's'; sem ela, um serviço qualquer
+            uint32_t other = neighbourCount > 0 ? neighbourList[s * neighbourCount + uniform_int_distribution<size_t>(0, neighbourCount - 1)(random)]
+                                                : uniform_int_distribution<uint32_t>(0, n - 1)(random);
+            m.r2 = state.routeOf[other];
+            if (m.type == RELOCATE) {
+                const vector<uint32_t>& r2 = current.routes[m.r2].services;
+                if (m.r2 == m.r1 || current.routes[m.r2].totalDemand + table.demand[serviceOf(r1[m.i1])] > capacity) return false;
+                m.i2 = state.posOf[other] + uniform_int_distribution<size_t>(0, 1)(random); // Antes ou depois do parceiro
+                m.delta1 = removalDelta(r1, m.i1);
+                m.delta2 = insertionDelta(r2, m.i2, r1[m.i1]);
+                return true;
+            }
+            m.i2 = state.posOf[other];
+            if (m.r1 == m.r2) return false;
+            const vector<uint32_t>& r2 = current.routes[m.r2].services;
+            int demandDelta = table.demand[serviceOf(r2[m.i2])] - table.demand[serviceOf(r1[m.i1])];
+            if (current.routes[m.r1].totalDemand + demandDelta > capacity || current.routes[m.r2].totalDemand - demandDelta > capacity) return false;
+            m.delta1 = replacementDelta(r1, m.i1, r2[m.i2]);
+            m.delta2 = replacementDelta(r2, m.i2, r1[m.i1]);
+            return true;
+        };
+
+        // Calibração: pioras de uma amostra de movimentos da solução inicial
+        vector<long long> worsening;
+        Sample m;
+        for (int k = 0; k < 2000; ++k) {
+            if (sample(m) && m.delta1 + m.delta2 > 0) worsening.push_back(m.delta1 + m.delta2);
+        }
+        if (worsening.empty()) worsening.push_back(1);
+        sort(worsening.begin(), worsening.end());
+        const double median = worsening[worsening.size() / 2], low = worsening[worsening.size() / 20];
+        const double initialTemperature = median / std::log(2.0);       // exp(-mediana / T0) = 0,5
+        const double finalTemperature = low / std::log(1000.0);         // exp(-percentil 5 / Tf) = 0,001
+        const long long moves = config.maxIterations > 0 ? config.maxIterations
+                              : config.timeLimitSeconds > 0 ? LLONG_MAX : 1000LL * n;
+        const double timeBudget = config.timeLimitSeconds * 1e6 - elapsed();
+        log("Recozimento: T0 = " + to_string(initialTemperature) + ", Tf = " + to_string(finalTemperature));
+
+        double temperature = initialTemperature;
+        bool bestPending = false;
+        long long bestCost = best.totalCost;
+        const auto annealingStart = elapsed();
+        long long step = 0;
+        for (; step < moves; ++step) {
+            if ((step & 1023) == 0) {
+                double progress = config.maxIterations > 0 || config.timeLimitSeconds <= 0 ? (double)step / moves : 0.0;
+                if (timeExpired()) break;
+                if (config.timeLimitSeconds > 0) {
+                    progress = max(progress, timeBudget > 0 ? (elapsed() - annealingStart) / timeBudget : 1.0);
+                }
+                temperature = initialTemperature * pow(finalTemperature / initialTemperature, min(1.0, progress));
+            }
+            if (!sample(m)) continue;
+            long long delta = m.delta1 + m.delta2;
+            if (delta > 0 && uniform_real_distribution<double>(0, 1)(random) >= exp(-delta / temperature)) continue;
+            if (delta > 0 && bestPending) { // A trajetória deixa um novo mínimo: guarda-o antes de piorar
+                best = current;
+                recordBest(best, start);
+                bestPending = false;
+            }
+            if (m.type == REVERSAL) {
+                applyReversal(current, state, m.r1, m.i1, m.i2, m.delta1);
+            } else if (m.type == RELOCATE) {
+                applyRelocate(current, state, m.r1, m.i1, m.r2, m.i2, m.delta1, m.delta2);
+                forward.resize(current.routes.size());
+                backward.resize(current.routes.size());
+                prefixStamp.resize(current.routes.size());
+            } else {
+                applySwap(current, state, m.r1, m.i1, m.r2, m.i2, m.delta1, m.delta2);
+            }
+            if (current.totalCost < bestCost) {
+                bestCost = current.totalCost;
+                bestPending = true;
+                noteCost(bestCost);
+            }
+        }
+        if (bestPending) {
+            best = current;
+            recordBest(best, start);
+        }
+        long long annealed = best.totalCost;
+        localSearch(best);
+        if (best.totalCost < annealed) recordBest(best, start);
+        log("Recozimento concluído após " + to_string(step) + " movimentos: " + to_string(annealed) + " (" + to_string(best.totalCost) + " após a busca local)");
+        return best;
+    }
+
+    /**
+     * @brief Destrói parte da solução, retirando os serviços escolhidos pelo operador 'op'
+     * (0: aleatórios; 1: de maior custo de remoção, com sorteio enviesado; 2: relacionados, os mais próximos
+     * de um serviço sorteado; 3: rotas inteiras sorteadas). Rotas que ficam vazias são removidas.
+     * @param count Número de serviços a retirar (a remoção de rotas retira pelo menos uma rota inteira).
+     * @return Os serviços retirados (sem o bit de sentido).
+     */
+    vector<uint32_t> destroy(Solution& solution, int op, size_t count, mt19937& random) {
+        const ServiceTable& table = *serviceTable;
+        const uint32_t n = table.size();
+        vector<char> removed(n, 0);
+        vector<uint32_t> out;
+        if (n == 0) return out;
+        auto take = [&](uint32_t s) { if (!removed[s]) { removed[s] = 1; out.push_back(s); } };
+        if (op == 0) {
+            vector<uint32_t> all(n);
+            for (uint32_t s = 0; s < n; ++s) all[s] = s;
+            shuffle(all.begin(), all.end(), random);
+            for (size_t k = 0; k < count; ++k) take(all[k]);
+        } else if (op == 1) {
+            vector<pair<long long, uint32_t>> saving; // Custo de deslocamento economizado ao retirar o serviço
+            for (const auto& route : solution.routes) {
+                for (size_t p = 0; p < route.services.size(); ++p) saving.push_back({-removalDelta(route.services, p), serviceOf(route.services[p])});
+            }
+            sort(saving.begin(), saving.end(), greater<pair<long long, uint32_t>>());
+            while (out.size() < count) { // Posição y³ * tamanho: favorece os mais caros sem ser determinístico
+                double y = uniform_real_distribution<double>(0, 1)(random);
+                size_t pick = min(saving.size() - 1, (size_t)(y * y * y * saving.size()));
+                take(saving[pick].second);
+                saving.erase(saving.begin() + pick);
+            }
+        } else if (op == 2) {
+            uint32_t seed = uniform_int_distribution<uint32_t>(0, n - 1)(random);
+            vector<pair<long long, uint32_t>> relatedness(n);
+            for (uint32_t s = 0; s < n; ++s) {
+                relatedness[s] = {s == seed ? -1 : min(dist(table.endOf(seed), table.startOf(s)), dist(table.endOf(s), table.startOf(seed))), s};
+            }
+            partial_sort(relatedness.begin(), relatedness.begin() + count, relatedness.end());
+            for (size_t k = 0; k < count; ++k) take(relatedness[k].second);
+        } else {
+            vector<size_t> order(solution.routes.size());
+            for (size_t r = 0; r < order.size(); ++r) order[r] = r;
+            shuffle(order.begin(), order.end(), random);
+            for (size_t k = 0; k < order.size() && (k == 0 || out.size() < count); ++k) {
+                for (uint32_t s : solution.routes[order[k]].services) take(serviceOf(s));
+            }
+        }
+        for (auto& route : solution.routes) {
+            route.services.erase(remove_if(route.services.begin(), route.services.end(), [&](uint32_t s) { return removed[serviceOf(s)]; }),
+                                 route.services.end());
+        }
+        solution.routes.erase(remove_if(solution.routes.begin(), solution.routes.end(), [](const Route& r) { return r.services.empty(); }),
+                              solution.routes.end());
+        recalculateSolutionMetrics(solution);
+        return out;
+    }
+
+    /**
+     * @struct Insertion
+     * @brief Melhor inserção de um serviço numa rota: a variação do custo de deslocamento, a posição e a
+     * visita (com o sentido escolhido, para arestas).
+     */
+    struct Insertion {
+        long long delta = INF;
+        size_t pos = 0;
+        uint32_t visit = 0;
+    };
+
+    /**
+     * @brief Melhor posição e sentido para inserir o serviço 's' na rota (sem olhar a capacidade).
+     */
+    Insertion bestInsertion(const vector<uint32_t>& route, uint32_t s) const {
+        Insertion best;
+        uint32_t reversed = serviceTable->reversed(s);
+        for (size_t pos = 0; pos <= route.size(); ++pos) {
+            long long delta = insertionDelta(route, pos, s);
+            if (delta < best.delta) best = {delta, pos, s};
+            if (reversed != s && (delta = insertionDelta(route, pos, reversed)) < best.delta) best = {delta, pos, reversed};
+        }
+        return best;
+    }
+
+    /**
+     * @brief Reinsere os serviços retirados. Com regret = 1, insere a cada passo o serviço de inserção mais
+     * barata (gulosa); com regret = k > 1, o de maior arrependimento: a soma das diferenças entre a
+     * melhor inserção e a 2ª, ..., k-ésima melhores rotas (regret-k), que prioriza os serviços com
+     * poucas boas opções. Abrir uma rota nova é sempre uma opção.
+     * A melhor inserção de cada serviço pendente em cada rota fica em cache e só é recalculada para a
+     * rota que recebeu a última inserção.
+     */
+    void repair(Solution& solution, vector<uint32_t> pending, int regret) {
+        const ServiceTable& table = *serviceTable;
+        vector<vector<Insertion>> cache(pending.size());
+        for (size_t i = 0; i < pending.size(); ++i) {
+            for (const auto& route : solution.routes) cache[i].push_back(bestInsertion(route.services, pending[i]));
+        }
+        vector<long long> options;
+        while (!pending.empty()) {
+            size_t chosen = 0, chosenRoute = 0;
+            long long chosenCost = INF, chosenRegret = -1;
+            for (size_t i = 0; i < pending.size(); ++i) {
+                uint32_t s = pending[i];
+                long long newRoute = calculateRouteCost(vector<uint32_t>{s}) - table.cost[s];
+                size_t bestRoute = solution.routes.size(); // Índice fora das rotas: abrir uma rota nova
+                long long bestCost = newRoute;
+                options.assign(1, newRoute);
+                for (size_t r = 0; r < solution.routes.size(); ++r) {
+                    if (solution.routes[r].totalDemand + table.demand[s] > capacity) continue;
+                    options.push_back(cache[i][r].delta);
+                    if (cache[i][r].delta < bestCost) {
+                        bestCost = cache[i][r].delta;
+                        bestRoute = r;
+                    }
+                }
+                long long regretValue = 0;
+                if (regret > 1) {
+                    size_t k = min<size_t>(regret, options.size());
+                    partial_sort(options.begin(), options.begin() + k, options.end());
+                    for (size_t j = 1; j < k; ++j) regretValue += options[j] - options[0];
+                }
+                if (regretValue > chosenRegret || (regretValue == chosenRegret && bestCost < chosenCost)) {
+                    chosen = i;
+                    chosenRoute = bestRoute;
+                    chosenCost = bestCost;
+                    chosenRegret = regretValue;
+                }
+            }
+            uint32_t s = pending[chosen];
+            if (chosenRoute == solution.routes.size()) {
+                Route route;
+                route.services.push_back(s);
+                solution.routes.push_back(route);
+                updateRoute(solution, chosenRoute, calculateRouteCost(route.services), table.demand[s]);
+                for (size_t i = 0; i < pending.size(); ++i) cache[i].push_back(Insertion());
+            } else {
+                const Insertion& insertion = cache[chosen][chosenRoute];
+                vector<uint32_t>& services = solution.routes[chosenRoute].services;
+                services.insert(services.begin() + insertion.pos, insertion.visit);
+                updateRoute(solution, chosenRoute, insertion.delta + table.cost[s], table.demand[s]);
+            }
+            pending.erase(pending.begin() + chosen);
+            cache.erase(cache.begin() + chosen);
+            for (size_t i = 0; i < pending.size(); ++i) cache[i][chosenRoute] = bestInsertion(solution.routes[chosenRoute].services, pending[i]);
+        }
+    }
+
+    /**
+     * @brief Busca adaptativa em vizinhança grande (ALNS): a cada iteração, um operador de destruição
+     * (aleatório, pior custo, relacionados ou rotas) retira de 5% a 30% dos serviços (no máximo 80) e um
+     * de reparo (guloso, regret-2 ou regret-3) os reinsere. Os operadores são sorteados por roleta com
+     * pesos adaptativos: cada uso pontua 33 se gerou uma nova melhor, 9 se melhorou a corrente e 13 se
+     * uma piora foi aceita; a cada 100 iterações, peso = 0,9 * peso + 0,1 * pontuação média.
+     * A aceitação é a do recozimento simulado, com temperatura inicial que aceita uma piora de 5% com
+     * probabilidade 1/2 e decai geometricamente até 1/1000 dela com a fração consumida do orçamento
+     * (sem orçamento, 2000 iterações). Novas melhores são polidas pela busca local.
+     * @param initial A solução construída.
+     * @param start O início de solve(), para registrar o instante em que a melhor foi encontrada.
+     */
+    Solution adaptiveLargeNeighbourhoodSearch(const Solution& initial, chrono::steady_clock::time_point start) {
+        const size_t n = serviceTable->size();
+        if (n == 0) return initial; // Sem serviços não há o que destruir
+        const int destroyOps = 4, repairOps = 3;
+        const size_t minRemoved = min(n, max<size_t>(2, n / 20)), maxRemoved = min(n, max(minRemoved, min<size_t>(80, n * 3 / 10)));
+        const long long iterations = config.maxIterations > 0 ? config.maxIterations : config.timeLimitSeconds > 0 ? LLONG_MAX : 2000;
+        const double timeBudget = config.timeLimitSeconds * 1e6;
+        mt19937 random(config.seed);
+        auto elapsed = [&]() { return chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count(); };
+
+        Solution current = initial;
+        localSearch(current);
+        Solution best = current;
+        recordBest(best, start);
+        const double initialTemperature = 0.05 * current.totalCost / std::log(2.0);
+
+        vector<double> weight(destroyOps + repairOps, 1.0), score(destroyOps + repairOps, 0.0), uses(destroyOps + repairOps, 0.0);
+        auto roulette = [&](int first, int count) {
+            double total = 0;
+            for (int op = first; op < first + count; ++op) total += weight[op];
+            double pick = uniform_real_distribution<double>(0, total)(random);
+            for (int op = first; op < first + count; ++op) {
+                if ((pick -= weight[op]) <= 0) return op - first;
+            }
+            return count - 1;
+        };
+        const long long segment = 100;
+        for (long long iteration = 0; iteration < iterations && !timeExpired(); ++iteration) {
+            double progress = config.timeLimitSeconds > 0 && config.maxIterations == 0 ? elapsed() / timeBudget : (double)iteration / iterations;
+            double temperature = initialTemperature * pow(1e-3, min(1.0, progress));
+            int destroyOp = roulette(0, destroyOps), repairOp = roulette(destroyOps, repairOps);
+            size_t count = uniform_int_distribution<size_t>(minRemoved, maxRemoved)(random);
+
+            Solution candidate = current;
+            vector<uint32_t> removed = destroy(candidate, destroyOp, count, random);
+            repair(candidate, removed, repairOp == 0 ? 1 : repairOp + 1);
+
+            double reward = 0;
+            long long delta = candidate.totalCost - current.totalCost;
+            if (candidate.totalCost < best.totalCost) {
+                localSearch(candidate);
+                best = candidate;
+                recordBest(best, start);
+                reward = 33;
+                log("ALNS: nova melhor solução na iteração " + to_string(iteration + 1) + ": " + to_string(best.totalCost));
+            } else if (delta < 0) {
+                reward = 9;
+            } else if (uniform_real_distribution<double>(0, 1)(random) < exp(-delta / temperature)) {
+                reward = delta > 0 ? 13 : 0;
+            } else {
+                reward = -1; // Rejeitada
+            }
+            if (reward >= 0) current = move(candidate);
+            for (int op : {destroyOp, destroyOps + repairOp}) {
+                score[op] += max(0.0, reward);
+                uses[op] += 1;
+            }
+            if ((iteration + 1) % segment == 0) {
+                for (int op = 0; op < destroyOps + repairOps; ++op) {
+                    if (uses[op] > 0) weight[op] = max(0.05, 0.9 * weight[op] + 0.1 * score[op] / uses[op]);
+                    score[op] = uses[op] = 0;
+                }
+            }
+        }
+        log("ALNS: pesos finais de destruição (aleatória, pior, relacionada, rota) = " + to_string(weight[0]) + ", " +
+            to_string(weight[1]) + ", " + to_string(weight[2]) + ", " + to_string(weight[3]));
+        return best;
+    }
+
+    /**
+     * @brief Limites inferiores baratos, calculados antes da busca:
+     * - veículos: ceil(demanda total / capacidade);
+     * - custo: a soma dos custos fixos dos serviços mais os deslocamentos mínimos. Cada serviço tem
+     *   exatamente um deslocamento de saída (para outro serviço ou de volta ao depósito), de pelo menos
+     *   o menor deslocamento possível a partir do seu fim; e cada uma das K rotas (K = limite de
+     *   veículos) começa num serviço diferente, então as idas do depósito somam pelo menos as K menores
+     *   distâncias do depósito ao início de um serviço. Simetricamente, com as chegadas e as K menores
+     *   voltas ao depósito; fica o maior dos dois. Arestas contam nos dois sentidos. O cálculo é O(n²).
+     */
+    void computeLowerBounds() {
+        ensureDistancesCalculated();
+        const ServiceTable& table = *serviceTable;
+        const uint32_t n = table.size();
+        long long totalDemand = 0, fixedCost = 0;
+        for (uint32_t s = 0; s < n; ++s) {
+            totalDemand += table.demand[s];
+            fixedCost += table.cost[s];
+        }
+        vehicleBound = n == 0 ? 0 : max<long long>(1, (totalDemand + capacity - 1) / capacity);
+        long long leaving = 0, arriving = 0;
+        vector<long long> fromDepot(n, INF), toDepot(n, INF);
+        for (uint32_t s = 0; s < n; ++s) {
+            long long out = INF, in = INF;
+            for (uint32_t x : {s, table.reversed(s)}) {
+                fromDepot[s] = min(fromDepot[s], dist(depot, table.startOf(x)));
+                toDepot[s] = min(toDepot[s], dist(table.endOf(x), depot));
+                for (uint32_t t = 0; t < n; ++t) {
+                    if (t == s) continue;
+                    for (uint32_t y : {t, table.reversed(t)}) {
+                        out = min(out, dist(table.endOf(x), table.startOf(y)));
+                        in = min(in, dist(table.endOf(y), table.startOf(x)));
+                    }
+                }
+            }
+            out = min(out, toDepot[s]);
+            in = min(in, fromDepot[s]);
+            leaving += out < INF ? out : 0;
+            arriving += in < INF ? in : 0;
+        }
+        size_t k = min<size_t>(vehicleBound, n);
+        partial_sort(fromDepot.begin(), fromDepot.begin() + k, fromDepot.end());
+        partial_sort(toDepot.begin(), toDepot.begin() + k, toDepot.end());
+        for (size_t r = 0; r < k; ++r) {
+            leaving += fromDepot[r] < INF ? fromDepot[r] : 0;
+            arriving += toDepot[r] < INF ? toDepot[r] : 0;
+        }
+        lowerBound = fixedCost + max(leaving, arriving);
+    }
+
+    /**
+     * @brief Distância entre dois serviços para o agrupamento: o menor deslocamento entre o fim de um e
+     * o início do outro, em qualquer ordem e com arestas em qualquer sentido.
+     */
+    long long serviceDistance(uint32_t a, uint32_t b) const {
+        const ServiceTable& table = *serviceTable;
+        long long best = INF;
+        for (uint32_t x : {a, table.reversed(a)}) {
+            for (uint32_t y : {b, table.reversed(b)}) {
+                best = min({best, dist(table.endOf(x), table.startOf(y)), dist(table.endOf(y), table.startOf(x))});
+            }
+        }
+        return best;
+    }
+
+    /**
+     * @brief Agrupa os serviços em 'k' grupos de demanda equilibrada.
+     * Por proximidade: k-medoides com sementes escolhidas da mais distante do depósito em diante (cada
+     * nova semente é o serviço mais distante das já escolhidas); os serviços são atribuídos, dos mais
+     * próximos de uma semente aos mais distantes, ao medoide mais próximo cujo grupo não passou de 120%
+     * da demanda média, e os medoides são recalculados duas vezes.
+     * Por setores: as instâncias não têm coordenadas, então o ângulo de cada serviço em torno do depósito
+     * é estimado pela lei dos cossenos com as distâncias a duas referências (o serviço mais distante do
+     * depósito e o mais próximo de 90° dele, que define o lado); os serviços são ordenados pelo ângulo e
+     * cortados em setores consecutivos de demanda igual.
+     * @return Os índices dos serviços de cada grupo não vazio.
+     */
+    vector<vector<uint32_t>> clusterServices(size_t k) const {
+        const ServiceTable& table = *serviceTable;
+        const uint32_t n = table.size();
+        k = max<size_t>(1, min<size_t>(k, n));
+        long long totalDemand = 0;
+        for (uint32_t s = 0; s < n; ++s) totalDemand += table.demand[s];
+        auto fromDepot = [&](uint32_t s) { return min(dist(depot, table.u[s]), dist(depot, table.v[s])); };
+        vector<vector<uint32_t>> groups(k);
+
+        if (config.decomposition == Decomposition::Sectors) {
+            uint32_t first = 0;
+            for (uint32_t s = 1; s < n; ++s) if (fromDepot(s) > fromDepot(first)) first = s;
+            // Cosseno do ângulo, no depósito, entre o serviço 's' e a referência 'ref'
+            auto cosine = [&](uint32_t ref, uint32_t s) {
+                double a = fromDepot(s), b = fromDepot(ref), c = serviceDistance(ref, s);
+                if (a == 0 || b == 0) return 1.0;
+                return max(-1.0, min(1.0, (a * a + b * b - c * c) / (2 * a * b)));
+            };
+            uint32_t second = first;
+            for (uint32_t s = 0; s < n; ++s) {
+                if (fabs(cosine(first, s)) < fabs(cosine(first, second)) && fromDepot(s) > 0) second = s;
+            }
+            vector<pair<double, uint32_t>> angle(n);
+            for (uint32_t s = 0; s < n; ++s) {
+                double theta = acos(cosine(first, s));
+                angle[s] = {cosine(second, s) >= 0 ? theta : 2 * acos(-1.0) - theta, s};
+            }
+            sort(angle.begin(), angle.end());
+            long long accumulated = 0;
+            for (const auto& [a, s] : angle) {
+                size_t g = min<size_t>(k - 1, accumulated * k / max(1LL, totalDemand));
+                groups[g].push_back(s);
+                accumulated += table.demand[s];
+            }
+        } else {
+            vector<uint32_t> medoid;
+            vector<long long> nearest(n, INF);
+            uint32_t first = 0;
+            for (uint32_t s = 1; s < n; ++s) if (fromDepot(s) > fromDepot(first)) first = s;
+            medoid.push_back(first);
+            while (medoid.size() < k) {
+                for (uint32_t s = 0; s < n; ++s) nearest[s] = min(nearest[s], serviceDistance(medoid.back(), s));
+                medoid.push_back(max_element(nearest.begin(), nearest.end()) - nearest.begin());
+            }
+            const double limit = 1.2 * totalDemand / k;
+            for (int round = 0; round < 3; ++round) {
+                vector<tuple<long long, uint32_t>> order(n);
+                for (uint32_t s = 0; s < n; ++s) {
+                    long long d = INF;
+                    for (uint32_t m : medoid) d = min(d, serviceDistance(m, s));
+                    order[s] = {d, s};
+                }
+                sort(order.begin(), order.end());
+                for (auto& g : groups) g.clear();
+                vector<long long> load(k, 0);
+                for (const auto& [d, s] : order) {
+                    size_t chosen = k, fallback = 0;
+                    for (size_t g = 0; g < k; ++g) {
+                        long long dg = serviceDistance(medoid[g], s);
+                        if (dg < serviceDistance(medoid[fallback], s)) fallback = g;
+                        if (load[g] + table.demand[s] <= limit && (chosen == k || dg < serviceDistance(medoid[chosen], s))) chosen = g;
+                    }
+                    if (chosen == k) chosen = fallback;
+                    groups[chosen].push_back(s);
+                    load[chosen] += table.demand[s];
+                }
+                if (round == 2) break;
+                for (size_t g = 0; g < k; ++g) { // Novo medoide: o serviço de menor distância total ao grupo
+                    long long bestSum = LLONG_MAX;
+                    for (uint32_t candidate : groups[g]) {
+                        long long sum = 0;
+                        for (uint32_t s : groups[g]) {
+                            long long d = serviceDistance(candidate, s);
+                            if (d >= INF || sum > INF - d) { sum = INF; break; } // Par sem caminho: o candidato não serve de medoide
+                            sum += d;
+                        }
+                        if (sum < bestSum) {
+                            bestSum = sum;
+                            medoid[g] = candidate;
+                        }
+                    }
+                }
+            }
+        }
+        groups.erase(remove_if(groups.begin(), groups.end(), [](const vector<uint32_t>& g) { return g.empty(); }), groups.end());
+        return groups;
+    }
+
+    /**
+     * @brief Decomposição geográfica: agrupa os serviços (clusterServices), resolve cada grupo como um
+     * Solver independente — com a mesma configuração, sem decomposição, semente seed + i e a matriz de
+     * distâncias já calculada — em 'searchThreads' threads, e junta as rotas numa solução da instância.
+     * Com limite de tempo, os subproblemas usam 70% dele, repartido entre as rodadas de threads; o
+     * restante fica para a busca local global que solve() aplica à solução juntada.
+     */
+    Solution decomposedSolution() {
+        vector<vector<uint32_t>> groups = clusterServices(config.clusters);
+        const size_t threads = min<size_t>(groups.size(), max(1, config.searchThreads));
+        const size_t rounds = (groups.size() + threads - 1) / threads;
+        log("Decomposição (" + decompositionName(config.decomposition) + "): " + to_string(groups.size()) + " grupos em " +
+            to_string(threads) + " thread(s)");
+        vector<Solution> parts(groups.size());
+        ThreadPool pool(threads);
+        pool.parallelFor(groups.size(), 1, [&](size_t begin, size_t end, unsigned) {
+            for (size_t g = begin; g < end; ++g) {
+                Solver sub(graph, depot, capacity, instanceName + "/grupo" + to_string(g + 1));
+                for (uint32_t s : groups[g]) sub.addService(allServices[s].id, allServices[s].type, allServices[s].u, allServices[s].v,
+                                                            allServices[s].demand, allServices[s].serviceCost, allServices[s].travelCost);
+                sub.setDistances(distances);
+                SolverConfig subConfig = config;
+                subConfig.clusters = 0;
+                subConfig.verbose = false;
+                subConfig.searchThreads = 1;
+                subConfig.seed = config.seed + g;
+                if (config.timeLimitSeconds > 0) subConfig.timeLimitSeconds = 0.7 * config.timeLimitSeconds / rounds;
+                sub.setConfig(subConfig);
+                parts[g] = sub.solve();
+            }
+        });
+
+        Solution solution;
+        solution.serviceTable = serviceTable;
+        for (size_t g = 0; g < groups.size(); ++g) {
+            if (parts[g].totalCost >= INF) {
+                solution.totalCost = INF;
+                return solution;
+            }
+            log("Grupo " + to_string(g + 1) + ": " + to_string(groups[g].size()) + " serviços, custo " + to_string(parts[g].totalCost));
+            for (auto& route : parts[g].routes) { // Índices locais do subproblema -> índices da instância
+                for (auto& visit : route.services) visit = groups[g][serviceOf(visit)] | (visit & REVERSED_VISIT);
+                route.id = solution.routes.size() + 1;
+                solution.routes.push_back(move(route));
+            }
+        }
+        recalculateSolutionMetrics(solution);
+        return solution;
+    }
+
+    /**
+     * @brief Orquestra todo o processo: construção da solução inicial, busca local e a metaheurística
+     * configurada (busca local iterada com multi-start, algoritmo memético, busca tabu, recozimento simulado ou ALNS).
+     * Com 'clusters' > 1, a solução de partida vem da decomposição (cada grupo resolvido com a metaheurística
+     * configurada) e recebe só uma busca local global. Com uma partida a quente (setWarmStart), a solução
+     * carregada substitui a construtiva e a decomposição.
+     * @return A melhor solução encontrada.
+     */
+    Solution solve() {
+        auto start = chrono::steady_clock::now();
+        rng.seed(config.seed);
+        deadline = config.timeLimitSeconds > 0
+            ? start + chrono::microseconds((long long)(config.timeLimitSeconds * 1e6))
+            : chrono::steady_clock::time_point::max();
+        log("Total de serviços a serem atendidos: " + to_string(allServices.size()));
+        ensureDistancesCalculated();
+        boundReached = false;
+        computeLowerBounds();
+        log("Limites inferiores: " + to_string(vehicleBound) + " veículo(s), custo " + to_string(lowerBound));
+        auto constructionStart = chrono::steady_clock::now();
+        const bool decomposed = !hasWarmStart && config.clusters > 1 && allServices.size() > 1;
+        Solution solution = hasWarmStart ? warmStart : decomposed ? decomposedSolution() : constructSolution(rng);
+        if (hasWarmStart) log("Partida a quente: solução carregada com custo " + to_string(solution.totalCost));
+        auto localSearchStart = chrono::steady_clock::now();
+        long long constructionTime = chrono::duration_cast<chrono::microseconds>(localSearchStart - constructionStart).count();
+        if (solution.totalCost < INF) {
+            log("Iniciando busca local...");
+            ensureNeighbourLists();
+            if (decomposed) {
+                log("Decomposição: custo após juntar os grupos " + to_string(solution.totalCost) + "; busca local global");
+                localSearch(solution);
+                recordBest(solution, start);
+            } else if (config.metaheuristic == Metaheuristic::Memetic) solution = memeticSearch(solution, start);
+            else if (config.metaheuristic == Metaheuristic::Tabu) solution = tabuSearch(solution, start);
+            else if (config.metaheuristic == Metaheuristic::Annealing) solution = simulatedAnnealing(solution, start);
+            else if (config.metaheuristic == Metaheuristic::Alns) solution = adaptiveLargeNeighbourhoodSearch(solution, start);
+            else solution = multiStartSearch(solution, start);
+            solution.localSearchTimeMicroseconds = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - localSearchStart).count();
+            log("Busca local concluida. Custo final: " + to_string(solution.totalCost));
+        } else {
+            if (config.verbose) cerr << "ERRO [" << instanceName << "]: Não foi possível construir uma solução inicial viável. Otimizacao abortada." << endl;
+        }
+        solution.constructionTimeMicroseconds = constructionTime;
+        auto end = chrono::steady_clock::now();
+        solution.executionTimeMicroseconds = chrono::duration_cast<chrono::microseconds>(end - start).count();
+        for(size_t i = 0; i < solution.routes.size(); ++i) {
+            solution.routes[i].id = i + 1;
+        }
+        return solution;
+    }
+
+    /**
+     * @brief Lê uma solução gravada por saveSolution e a converte para os índices desta instância.
+     * Cada "(S id,u,v)" vira o serviço 'id'; uma aresta com os extremos trocados recebe REVERSED_VISIT.
+     * A solução só é aceita se atende cada serviço exatamente uma vez, nos extremos da instância,
+     * respeita a capacidade e tem o custo declarado igual ao recalculado (o que descarta arquivos
+     * gerados para outra versão da instância).
+     * @param path Caminho do arquivo sol-*.dat.
+     * @param solution Solução lida, com custos e demandas recalculados.
+     * @param error Motivo da rejeição, caso o arquivo não sirva.
+     * @return True se a solução foi lida e é válida.
+     */
+    bool loadSolution(const string& path, Solution& solution, string& error) {
+        SolutionFile file;
+        if (!readSolutionFile(path, file, error)) return false;
+        if (file.infeasible) { error = "solução marcada como inviável"; return false; }
+
+        const ServiceTable& table = *serviceTable;
+        vector<char> served(table.size(), 0);
+        solution = Solution();
+        solution.serviceTable = serviceTable;
+        for (const auto& fileRoute : file.routes) {
+            Route route;
+            route.id = solution.routes.size() + 1;
+            for (const auto& visit : fileRoute.visits) {
+                if (visit.type == 'D') continue;
+                if (visit.type != 'S' || visit.serviceId < 1 || visit.serviceId > (int)table.size()) {
+                    error = "serviço desconhecido " + to_string(visit.serviceId);
+                    return false;
+                }
+                uint32_t s = visit.serviceId - 1;
+                int u = table.u[s] + 1, v = table.v[s] + 1;
+                if (served[s]++) { error = "serviço " + to_string(visit.serviceId) + " atendido mais de uma vez"; return false; }
+                if (table.type[s] == 'E' && visit.u == v && visit.v == u && u != v) s |= REVERSED_VISIT;
+                else if (visit.u != u || visit.v != v) {
+                    error = "serviço " + to_string(visit.serviceId) + " com extremos incorretos";
+                    return false;
+                }
+                route.services.push_back(s);
+            }
+            solution.routes.push_back(move(route));
+        }
+        for (size_t s = 0; s < served.size(); ++s) {
+            if (!served[s]) { error = "serviço " + to_string(table.id[s]) + " não atendido"; return false; }
+        }
+        recalculateSolutionMetrics(solution);
+        for (const auto& route : solution.routes) {
+            if (route.totalDemand > capacity) { error = "rota com demanda " + to_string(route.totalDemand) + " acima da capacidade"; return false; }
+        }
+        if (solution.totalCost >= INF || solution.totalCost != file.totalCost) {
+            error = "custo declarado " + to_string(file.totalCost) + ", recalculado " + to_string(solution.totalCost);
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Define a solução de partida da próxima chamada a solve(), no lugar da construtiva.
+     * A solução deve ser válida para esta instância (ver loadSolution).
+     */
+    void setWarmStart(const Solution& solution) {
+        warmStart = solution;
+        hasWarmStart = true;
+    }
+
+    /**
+     * @brief Salva a solução final em um arquivo, seguindo o formato especificado.
+     * @param solution A solução a ser salva.
+     * @param instanceName O nome do arquivo de saída.
+     */
+    void saveSolution(const Solution& solution, const string& instanceName) {
+        string dirPath = "solucoes";
+        try { if (!filesystem::exists(dirPath)) filesystem::create_directories(dirPath); }
+        catch (const exception& e) { cerr << "Erro ao criar diretório " << dirPath << ": " << e.what() << endl; return; }
+        string solutionPath = dirPath + "/sol-" + instanceName;
+        ofstream out(solutionPath);
+        if (!out.is_open()) { cerr << "Erro ao criar arquivo de solucao em: " << solutionPath << endl; return; }
+        if (solution.totalCost >= INF || (solution.routes.empty() && !allServices.empty()) ) {
+            out << "inviavel" << endl;
+        } else {
+            out << solution.totalCost << endl;
+            out << solution.routes.size() << endl;
+            out << solution.executionTimeMicroseconds << endl;
+            out << solution.bestTimeMicroseconds << endl;
+            for (const auto& route : solution.routes) {
+                out << " 0 1 " << route.id << " " << route.totalDemand << " " << route.totalCost 
+                    << " " << (route.services.size() + 2);
+                out << " (D 0," << depot + 1 << "," << depot + 1 << ")";
+                for (uint32_t s : route.services) {
+                    out << " (S " << serviceTable->id[serviceOf(s)] << "," << serviceTable->startOf(s) + 1 << "," << serviceTable->endOf(s) + 1 << ")";
+                }
+                out << " (D 0," << depot + 1 << "," << depot + 1 << ")";
+                out << endl;
+            }
+        }
+        out.close();
+        if(solution.totalCost < INF) {
+            cout << "Solucao salva em: " << solutionPath << endl;
+            cout << "  - Custo Total: " << solution.totalCost << endl;
+            cout << "  - N. de Rotas: " << solution.routes.size() << endl;
+            if (lowerBound > 0) {
+                cout << "  - Limite Inferior: " << lowerBound << " (gap " << fixed << setprecision(2)
+                     << 100.0 * (solution.totalCost - lowerBound) / lowerBound << "%)" << defaultfloat << endl;
+            }
         }
     }
 };
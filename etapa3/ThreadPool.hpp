@@ -0,0 +1,106 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <functional>
+#include <condition_variable>
+#include <algorithm>
+
+using namespace std;
+
+/**
+ * @class ThreadPool
+ * @brief Equipe fixa de threads para laços paralelos curtos e repetidos (ex.: uma avaliação de
+ * vizinhança por iteração da busca local), evitando criar threads a cada chamada.
+ * A thread que chama run() participa como trabalhador 0; as demais ficam bloqueadas entre as rodadas.
+ */
+class ThreadPool {
+private:
+    vector<thread> workers;
+    mutex mtx;
+    condition_variable wake, finished;
+    const function<void(unsigned)>* task = nullptr;
+    size_t generation = 0;
+    unsigned pending = 0;
+    bool stopping = false;
+
+    void workerLoop(unsigned id) {
+        size_t seen = 0;
+        while (true) {
+            const function<void(unsigned)>* current;
+            {
+                unique_lock<mutex> lock(mtx);
+                wake.wait(lock, [&]{ return stopping || generation != seen; });
+                if (stopping) return;
+                seen = generation;
+                current = task;
+            }
+            (*current)(id);
+            lock_guard<mutex> lock(mtx);
+            if (--pending == 0) finished.notify_one();
+        }
+    }
+
+public:
+    /**
+     * @param size Número total de participantes, incluindo a thread que chama run().
+     */
+    explicit ThreadPool(unsigned size) {
+        for (unsigned id = 1; id < max(1u, size); ++id) workers.emplace_back(&ThreadPool::workerLoop, this, id);
+    }
+
+    ~ThreadPool() {
+        {
+            lock_guard<mutex> lock(mtx);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& t : workers) t.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    unsigned size() const { return workers.size() + 1; }
+
+    /**
+     * @brief Executa job(id) uma vez em cada participante (id em [0, size())) e espera todos terminarem.
+     */
+    void run(const function<void(unsigned)>& job) {
+        if (workers.empty()) { job(0); return; }
+        {
+            lock_guard<mutex> lock(mtx);
+            task = &job;
+            pending = workers.size();
+            generation++;
+        }
+        wake.notify_all();
+        job(0);
+        unique_lock<mutex> lock(mtx);
+        finished.wait(lock, [&]{ return pending == 0; });
+    }
+
+    /**
+     * @brief Divide o intervalo [0, count) em blocos de 'chunk' itens distribuídos dinamicamente
+     * entre os participantes; body(begin, end, id) processa um bloco.
+     */
+    template <typename Body>
+    void parallelFor(size_t count, size_t chunk, Body body) {
+        chunk = max<size_t>(1, chunk);
+        if (workers.empty() || count <= chunk) {
+            if (count > 0) body(0, count, 0u);
+            return;
+        }
+        atomic<size_t> next{0};
+        run([&](unsigned id) {
+            for (size_t begin = next.fetch_add(chunk); begin < count; begin = next.fetch_add(chunk)) {
+                body(begin, min(count, begin + chunk), id);
+            }
+        });
+    }
+};
+
+#endif
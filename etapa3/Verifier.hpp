@@ -0,0 +1,136 @@
+#ifndef VERIFIER_HPP
+#define VERIFIER_HPP
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <memory>
+#include "Graph.hpp"
+#include "Solver.hpp"
+#include "Parser.hpp"
+#include "SolutionFile.hpp"
+
+using namespace std;
+
+/**
+ * @struct VerificationReport
+ * @brief Resultado da verificação de um arquivo de solução contra sua instância.
+ */
+struct VerificationReport {
+    string solutionFile;
+    bool valid = true;
+    long long declaredCost = 0;
+    long long computedCost = 0;
+    long long optimalValue = -1;
+    int numRoutes = 0;
+    vector<string> errors;
+
+    void fail(const string& message) {
+        valid = false;
+        if (errors.size() < 10) errors.push_back(message);
+    }
+};
+
+/**
+ * @brief Verifica uma solução: recalcula demanda e custo de cada rota usando as distâncias
+ * mínimas (um Floyd-Warshall próprio sobre o grafo lido, sem passar pelo cálculo de custo do Solver), confere a capacidade, a cobertura de cada serviço exatamente uma vez e o cabeçalho,
+ * e compara o custo com o "Optimal value" da instância. Arestas ('E') podem aparecer em qualquer
+ * sentido; arcos e nós, só como na instância.
+ * @param solutionPath Caminho do arquivo sol-*.dat.
+ * @param instancePath Caminho do arquivo de instância correspondente.
+ * @return O relatório da verificação.
+ */
+inline VerificationReport verifySolution(const string& solutionPath, const string& instancePath) {
+    VerificationReport report;
+    report.solutionFile = fs::path(solutionPath).filename().string();
+
+    SolutionFile file;
+    string error;
+    if (!readSolutionFile(solutionPath, file, error)) { report.fail(error); return report; }
+    if (file.infeasible) { report.fail("solução marcada como inviável"); return report; }
+
+    Graph* rawGraph = nullptr;
+    unique_ptr<Solver> solver(parseInputFile(instancePath, rawGraph));
+    unique_ptr<Graph> graph(rawGraph);
+    if (!solver) { report.fail("falha ao ler a instância " + instancePath); return report; }
+
+    const vector<Service>& instanceServices = solver->getServices();
+    const int depot = solver->getDepot() + 1;
+    // Distâncias mínimas calculadas aqui, direto do grafo lido, para que o custo não dependa do código do Solver
+    const vector<vector<long long>> dist = graph->floydWarshall();
+    auto add = [](long long a, long long b) { return (a >= INF || b >= INF) ? INF : a + b; };
+    report.optimalValue = solver->getOptimalValue();
+    report.declaredCost = file.totalCost;
+    report.numRoutes = file.routes.size();
+
+    if (file.numRoutes != (int)file.routes.size()) {
+        report.fail("cabeçalho declara " + to_string(file.numRoutes) + " rotas, arquivo contém " + to_string(file.routes.size()));
+    }
+
+    vector<int> timesServed(instanceServices.size() + 1, 0);
+    for (const auto& route : file.routes) {
+        string tag = "rota " + to_string(route.id) + ": ";
+        if ((int)route.visits.size() != route.visitCount) {
+            report.fail(tag + "declara " + to_string(route.visitCount) + " visitas, contém " + to_string(route.visits.size()));
+        }
+        if (route.visits.size() < 2 || route.visits.front().type != 'D' || route.visits.back().type != 'D' ||
+            route.visits.front().u != depot || route.visits.back().u != depot) {
+            report.fail(tag + "não começa e termina no depósito");
+        }
+
+        int demand = 0;
+        long long cost = 0;
+        int node = depot - 1;
+        for (const auto& visit : route.visits) {
+            if (visit.type == 'D') continue;
+            if (visit.type != 'S' || visit.serviceId < 1 || visit.serviceId > (int)instanceServices.size()) {
+                report.fail(tag + "serviço desconhecido " + to_string(visit.serviceId));
+                continue;
+            }
+            const Service& service = instanceServices[visit.serviceId - 1];
+            int u = service.u + 1, v = service.v + 1;
+            int from = service.u, to = service.v;
+            if (service.type == 'E' && visit.u == v && visit.v == u && u != v) {
+                swap(from, to); // Aresta percorrida de v para u
+            } else if (visit.u != u || visit.v != v) {
+                report.fail(tag + "serviço " + to_string(visit.serviceId) + " com extremos incorretos");
+            }
+            timesServed[visit.serviceId]++;
+            demand += service.demand;
+            cost = add(cost, add(dist[node][from], service.serviceCost + (service.type != 'N' ? service.travelCost : 0)));
+            node = to;
+        }
+        cost = add(cost, dist[node][depot - 1]);
+
+        report.computedCost = add(report.computedCost, cost);
+        if (demand > solver->getCapacity()) {
+            report.fail(tag + "demanda " + to_string(demand) + " excede a capacidade " + to_string(solver->getCapacity()));
+        }
+        if (demand != route.demand) {
+            report.fail(tag + "demanda declarada " + to_string(route.demand) + ", recalculada " + to_string(demand));
+        }
+        if (cost != route.cost) {
+            report.fail(tag + "custo declarado " + to_string(route.cost) + ", recalculado " + to_string(cost));
+        }
+    }
+
+    for (size_t id = 1; id < timesServed.size(); ++id) {
+        if (timesServed[id] != 1) {
+            report.fail("serviço " + to_string(id) + " atendido " + to_string(timesServed[id]) + " vezes");
+        }
+    }
+    if (file.bestTime > file.totalTime) {
+        report.fail("instante da melhor solução " + to_string(file.bestTime) + " maior que o tempo total " + to_string(file.totalTime));
+    }
+    if (report.computedCost != file.totalCost) {
+        report.fail("custo total declarado " + to_string(file.totalCost) + ", recalculado " + to_string(report.computedCost));
+    }
+    if (report.optimalValue > 0 && report.computedCost < report.optimalValue) {
+        report.fail("custo " + to_string(report.computedCost) + " abaixo do ótimo conhecido " + to_string(report.optimalValue));
+    }
+    return report;
+}
+
+#endif
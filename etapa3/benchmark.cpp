@@ -0,0 +1,145 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <memory>
+#include "Graph.hpp"
+#include "Solver.hpp"
+#include "Parser.hpp"
+#include "Cli.hpp"
+
+using namespace std;
+
+/**
+ * @struct BenchmarkRow
+ * @brief Resultado de uma configuração do solver em uma instância.
+ */
+struct BenchmarkRow {
+    string instance;
+    string construction;
+    int neighbours;
+    long long initialCost;
+    long long cost;
+    long long constructionTime;
+    long long localSearchTime;
+};
+
+/**
+ * @brief Comparação de custo e tempo entre configurações do solver: heurísticas construtivas e
+ * tamanhos de vizinhança. Cada instância é resolvida uma vez por combinação, em sequência, para que
+ * os tempos sejam comparáveis; a primeira combinação é a referência do custo relativo.
+ * Uso: ./benchmark [--instances <lista>] [--constructors uma-rota,path-scanning] [--neighbours 0,10,20,40] [--csv arquivo.csv]
+ * k = 0 é a vizinhança completa.
+ */
+int main(int argc, char* argv[]) {
+    vector<string> patterns;
+    vector<int> ks = {0, 10, 20, 40};
+    vector<Construction> constructions = {SolverConfig().construction};
+    string csvPath;
+    auto usage = [&]() {
+        cerr << "Uso: " << argv[0] << " [--instances <lista>] [--constructors uma-rota,path-scanning] [--neighbours 0,10,20,40] [--csv arquivo.csv]" << endl;
+        return 2;
+    };
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (i + 1 >= argc) return usage();
+        stringstream ss(argv[++i]);
+        string item;
+        if (arg == "--instances") {
+            while (getline(ss, item, ',')) if (!item.empty()) patterns.push_back(item);
+        } else if (arg == "--constructors") {
+            constructions.clear();
+            while (getline(ss, item, ',')) {
+                Construction c;
+                if (!parseConstruction(item, c)) {
+                    cerr << "heurística construtiva desconhecida: " << item << endl;
+                    return 2;
+                }
+                constructions.push_back(c);
+            }
+        } else if (arg == "--neighbours") {
+            ks.clear();
+            while (getline(ss, item, ',')) {
+                if (item.empty()) continue;
+                int k = -1;
+                size_t used = 0;
+                try { k = stoi(item, &used); } catch (const exception&) {}
+                if (used != item.size() || k < 0) {
+                    cerr << "valor inválido para --neighbours: " << item << endl;
+                    return usage();
+                }
+                ks.push_back(k);
+            }
+        } else if (arg == "--csv") {
+            csvPath = ss.str();
+        } else {
+            cerr << "opção desconhecida: " << arg << endl;
+            return 2;
+        }
+    }
+
+    vector<string> files = resolveInstances(patterns);
+    if (files.empty() || ks.empty() || constructions.empty()) {
+        cerr << "Nada a executar: nenhuma instância, heurística construtiva ou valor de k" << endl;
+        return 1;
+    }
+
+    vector<BenchmarkRow> rows;
+    const size_t configs = constructions.size() * ks.size();
+    cout << left << setw(28) << "instancia" << setw(25) << "construtiva" << right << setw(5) << "k" << setw(12) << "inicial"
+         << setw(12) << "custo" << setw(14) << "constr. (ms)" << setw(13) << "busca (ms)" << endl;
+    for (const auto& filename : files) {
+        Graph* rawGraph = nullptr;
+        unique_ptr<Solver> solver(parseInputFile("entradas/" + filename, rawGraph));
+        unique_ptr<Graph> graph(rawGraph);
+        if (!solver) continue;
+        solver->precomputeDistances();
+        for (Construction construction : constructions) {
+            for (int k : ks) {
+                SolverConfig config;
+                config.verbose = false;
+                config.construction = construction;
+                config.neighbours = k;
+                solver->setConfig(config);
+                mt19937 random(config.seed);
+                long long initialCost = solver->constructSolution(random).totalCost;
+                Solution solution = solver->solve();
+                rows.push_back({filename, constructionName(construction), k, initialCost, solution.totalCost,
+                                solution.constructionTimeMicroseconds, solution.localSearchTimeMicroseconds});
+                cout << left << setw(28) << filename << setw(25) << constructionName(construction) << right << setw(5) << k
+                     << setw(12) << initialCost << setw(12) << solution.totalCost << setw(14) << fixed << setprecision(1)
+                     << solution.constructionTimeMicroseconds / 1000.0 << setw(13) << solution.localSearchTimeMicroseconds / 1000.0 << endl;
+            }
+        }
+    }
+
+    // Agregado por combinação: custo relativo à primeira (em média) e tempo total de construção + busca
+    cout << "\n" << left << setw(25) << "construtiva" << right << setw(5) << "k" << setw(16) << "custo rel. (%)"
+         << setw(16) << "tempo total (s)" << endl;
+    for (size_t j = 0; j < configs; ++j) {
+        double relative = 0, time = 0;
+        int count = 0;
+        for (size_t i = j; i < rows.size(); i += configs) {
+            const BenchmarkRow& base = rows[i - j];
+            if (base.cost > 0 && base.cost < INF && rows[i].cost < INF) {
+                relative += 100.0 * rows[i].cost / base.cost;
+                count++;
+            }
+            time += (rows[i].constructionTime + rows[i].localSearchTime) / 1e6;
+        }
+        cout << left << setw(25) << rows[j].construction << right << setw(5) << rows[j].neighbours << setw(16) << setprecision(2)
+             << (count ? relative / count : 0.0) << setw(16) << setprecision(3) << time << endl;
+    }
+
+    if (!csvPath.empty()) {
+        ofstream out(csvPath);
+        out << "instance,construction,neighbours,initial_cost,cost,construction_us,local_search_us" << endl;
+        for (const auto& r : rows) {
+            out << r.instance << "," << r.construction << "," << r.neighbours << "," << r.initialCost << "," << r.cost << ","
+                << r.constructionTime << "," << r.localSearchTime << endl;
+        }
+    }
+    return 0;
+}
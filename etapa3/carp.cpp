@@ -0,0 +1,10 @@
+#include <memory>
+#include "Carp.hpp"
+
+Solution solveInstance(const Instance& instance, const SolverConfig& config) {
+    Graph* rawGraph = nullptr;
+    unique_ptr<Solver> solver(createSolver(instance, rawGraph));
+    unique_ptr<Graph> graph(rawGraph);
+    solver->setConfig(config);
+    return solver->solve();
+}
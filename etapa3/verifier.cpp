@@ -0,0 +1,126 @@
+#include <iostream>
+#include <iomanip>
+#include <filesystem>
+#include <vector>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include "Verifier.hpp"
+
+using namespace std;
+namespace fs = std::filesystem;
+
+/**
+ * @brief Lista os arquivos sol-*.dat de uma pasta, em ordem alfabética.
+ */
+vector<string> getSolutionFiles(const string& folderPath) {
+    vector<string> files;
+    if (!fs::exists(folderPath)) {
+        cerr << "Pasta não encontrada: " << folderPath << endl;
+        return files;
+    }
+    for (const auto& entry : fs::directory_iterator(folderPath)) {
+        string filename = entry.path().filename().string();
+        if (entry.is_regular_file() && filename.rfind("sol-", 0) == 0 && entry.path().extension() != ".hash") {
+            files.push_back(filename);
+        }
+    }
+    sort(files.begin(), files.end());
+    return files;
+}
+
+/**
+ * @brief Verificador de soluções: confere cada sol-*.dat de 'solucoes' contra sua instância
+ * em 'entradas', distribuindo os arquivos entre várias threads.
+ * Uso: ./verifier [-j threads] [sol-arquivo.dat ...]
+ */
+int main(int argc, char* argv[]) {
+    unsigned numThreads = max(1u, thread::hardware_concurrency());
+    vector<string> files;
+    bool namedFiles = false;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "-j") {
+            int value = 0;
+            size_t used = 0;
+            try {
+                if (i + 1 >= argc) throw invalid_argument("valor ausente");
+                string text = argv[++i];
+                value = stoi(text, &used);
+                if (used != text.size()) throw invalid_argument(text);
+            } catch (const exception&) {
+                value = 0;
+            }
+            if (value < 1) {
+                cerr << "ERRO: -j exige um número positivo de threads" << endl;
+                cerr << "Uso: " << argv[0] << " [-j threads] [sol-arquivo.dat ...]" << endl;
+                return 2;
+            }
+            numThreads = value;
+        } else {
+            namedFiles = true;
+            string filename = fs::path(arg).filename().string();
+            if (filename.size() > 4 && filename.rfind("sol-", 0) == 0) files.push_back(filename);
+            else cerr << "Ignorado (não é um arquivo sol-*): " << arg << endl;
+        }
+    }
+    if (namedFiles && files.empty()) {
+        cerr << "Nenhum dos arquivos informados é um sol-*" << endl;
+        return 2;
+    }
+    if (files.empty()) files = getSolutionFiles("solucoes");
+    if (files.empty()) {
+        cout << "Nenhum arquivo sol-*.dat encontrado na pasta 'solucoes'" << endl;
+        return 1;
+    }
+
+    vector<VerificationReport> reports(files.size());
+    atomic<size_t> next{0};
+    auto worker = [&]() {
+        for (size_t i = next++; i < files.size(); i = next++) {
+            try {
+                reports[i] = verifySolution("solucoes/" + files[i], "entradas/" + files[i].substr(4));
+            } catch (const exception& e) {
+                reports[i] = VerificationReport();
+                reports[i].solutionFile = files[i];
+                reports[i].fail(string("erro ao verificar: ") + e.what());
+            }
+        }
+    };
+    vector<thread> workers;
+    for (unsigned t = 0; t < min<size_t>(numThreads, files.size()); ++t) workers.emplace_back(worker);
+    for (auto& w : workers) w.join();
+
+    int validas = 0, otimas = 0, comOtimo = 0;
+    double somaGap = 0;
+    for (const auto& report : reports) {
+        if (!report.valid) {
+            cout << "ERRO " << report.solutionFile << endl;
+            for (const auto& e : report.errors) cout << "     - " << e << endl;
+            continue;
+        }
+        validas++;
+        cout << "OK   " << report.solutionFile << "  custo=" << report.computedCost << "  rotas=" << report.numRoutes;
+        if (report.optimalValue > 0) {
+            double gap = 100.0 * (report.computedCost - report.optimalValue) / report.optimalValue;
+            cout << "  otimo=" << report.optimalValue << "  gap=" << fixed << setprecision(2) << gap << "%";
+            comOtimo++;
+            somaGap += gap;
+            if (report.computedCost == report.optimalValue) otimas++;
+        }
+        cout << endl;
+    }
+
+    cout << "\n" << string(60, '=') << endl;
+    cout << "RESUMO DA VERIFICACAO" << endl;
+    cout << string(60, '=') << endl;
+    cout << "Arquivos verificados: " << reports.size() << endl;
+    cout << "  - Validos: " << validas << endl;
+    cout << "  - Invalidos: " << (reports.size() - validas) << endl;
+    if (comOtimo > 0) {
+        cout << "  - Com otimo conhecido: " << comOtimo << " (otimos atingidos: " << otimas
+             << ", gap medio: " << fixed << setprecision(2) << somaGap / comOtimo << "%)" << endl;
+    }
+    return validas == (int)reports.size() ? 0 : 1;
+}